@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "informer/json_writer.hpp"
+
+namespace {
+
+using namespace os::network;
+
+/**
+ * @brief Создает синтетический снимок: у каждого интерфейса несколько адресов, маршрутов и соседей
+ * @param count Количество интерфейсов
+ */
+std::vector<Json> make_snapshot(std::size_t const count) {
+    std::vector<Json> interfaces(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Json &info = interfaces[i];
+        info.interface = fmt::format("veth{}", i);
+        info.general = {"UP", "BROADCAST", {"BROADCAST", "MULTICAST", "UP", "LOWER_UP"}, static_cast<int>(i + 2)};
+        info.hw = {"Ethernet", {fmt::format("02:00:{:02x}:{:02x}:00:01", (i >> 8) & 0xff, i & 0xff)}, 1500, 1000};
+        info.operational_status = {"UP", "DEFAULT"};
+        info.protocols = {true, true};
+        info.tx = {i * 1500 * 1000, i * 1000, 0, 0};
+        info.rx = {i * 1400 * 1000, i * 900, 1, 2};
+        info.ip = {{"IPv4", fmt::format("10.{}.{}.1/24", (i >> 8) & 0xff, i & 0xff), fmt::format("10.{}.{}.255", (i >> 8) & 0xff, i & 0xff), "", {"PERMANENT"}, 24, 0xffffffff, 0xffffffff},
+                   {"IPv6", fmt::format("fe80::{:x}/64", i + 1), "", "", {"PERMANENT"}, 64, 0xffffffff, 0xffffffff}};
+        info.routes = {{fmt::format("10.{}.{}.0/24", (i >> 8) & 0xff, i & 0xff), "", "UNICAST", 0, 254},
+                       {fmt::format("10.{}.{}.1", (i >> 8) & 0xff, i & 0xff), "", "LOCAL", 0, 255},
+                       {"fe80::/64", "", "UNICAST", 256, 254}};
+        info.neigh = {{fmt::format("10.{}.{}.2", (i >> 8) & 0xff, i & 0xff), "02:00:00:00:00:02", {"REACHABLE"}}};
+    }
+    return interfaces;
+}
+
+/**
+ * @brief Сериализация через nlohmann::json, как в get_all_interfaces_info
+ */
+void BM_DomDump(benchmark::State &state) {
+    auto const interfaces = make_snapshot(static_cast<std::size_t>(state.range(0)));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        nlohmann::json json{};
+        json["interfaces"] = interfaces;
+        std::string out = json.dump();
+        bytes += out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_DomDump)->Arg(1024)->Arg(8192);
+
+/**
+ * @brief Потоковая сериализация в строку
+ */
+void BM_StreamString(benchmark::State &state) {
+    auto const interfaces = make_snapshot(static_cast<std::size_t>(state.range(0)));
+
+    std::string reference = nlohmann::json{{"interfaces", interfaces}}.dump();
+    std::string check;
+    write_json(check, interfaces);
+    if (check != reference) {
+        state.SkipWithError("Output differs from nlohmann::json::dump()");
+        return;
+    }
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::string out;
+        write_json(out, interfaces);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_StreamString)->Arg(1024)->Arg(8192);
+
+/**
+ * @brief Потоковая сериализация в файловый дескриптор (/dev/null)
+ */
+void BM_StreamFd(benchmark::State &state) {
+    auto const interfaces = make_snapshot(static_cast<std::size_t>(state.range(0)));
+    int const fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        state.SkipWithError("Cannot open /dev/null");
+        return;
+    }
+    for (auto _ : state) {
+        write_json(fd, interfaces);
+    }
+    ::close(fd);
+}
+BENCHMARK(BM_StreamFd)->Arg(1024)->Arg(8192);
+
+} // namespace
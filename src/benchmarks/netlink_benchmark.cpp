@@ -0,0 +1,622 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <net/if.h>
+#include <netlink/route/addr.h>
+#include <netlink/route/link.h>
+#include <netlink/route/link/veth.h>
+#include <netlink/route/neighbour.h>
+#include <netlink/route/route.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+#include "informer/json_writer.hpp"
+#include "informer/netlink_dump.hpp"
+
+// Подсчёт выделений памяти через operator new. Замена действует и внутри libinterface_informer,
+// поэтому в счётчики попадают строки, векторы и JSON-узлы, которые строит printer.cpp; выделения
+// самой libnl (malloc) не учитываются.
+namespace {
+std::atomic<uint64_t> g_allocations{0};     /**< Количество вызовов operator new */
+std::atomic<uint64_t> g_allocated_bytes{0}; /**< Суммарный запрошенный объём */
+} // namespace
+
+void *operator new(std::size_t const size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *const pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t const size) { return ::operator new(size); }
+
+void operator delete(void *const pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void *const pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *const pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete[](void *const pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using namespace os::network;
+
+std::size_t g_interface_count = 2000; /**< Количество синтетических интерфейсов (--interfaces=N) */
+std::size_t g_route_count = 0;        /**< Количество дополнительных префиксов в 32.0.0.0/3 (--routes=N) */
+std::string g_probe_interface{};      /**< Интерфейс для одиночных запросов (середина списка) */
+std::string g_replay_path{};          /**< Дамп для воспроизведения вместо живого ядра (--replay=PATH) */
+std::string g_record_path{};          /**< Файл для записи дампа синтетической топологии (--record=PATH) */
+
+/**
+ * @class AllocationScope
+ * @brief Снимает показания счётчиков выделений на время цикла бенчмарка
+ */
+class AllocationScope final {
+   public:
+    explicit AllocationScope(benchmark::State &state)
+        : m_state{state},
+          m_allocations{g_allocations.load(std::memory_order_relaxed)},
+          m_bytes{g_allocated_bytes.load(std::memory_order_relaxed)} {}
+
+    ~AllocationScope() {
+        auto const allocations = g_allocations.load(std::memory_order_relaxed) - m_allocations;
+        auto const bytes = g_allocated_bytes.load(std::memory_order_relaxed) - m_bytes;
+        m_state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+        m_state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(bytes), benchmark::Counter::kAvgIterations,
+                                                             benchmark::Counter::kIs1024);
+        m_state.counters["interfaces"] = static_cast<double>(g_interface_count);
+    }
+
+    AllocationScope(AllocationScope const &) = delete;
+    AllocationScope(AllocationScope &&) = delete;
+    AllocationScope &operator=(AllocationScope const &) = delete;
+    AllocationScope &operator=(AllocationScope &&) = delete;
+
+   private:
+    benchmark::State &m_state; /**< Состояние бенчмарка */
+    uint64_t m_allocations;    /**< Показание счётчика вызовов на входе */
+    uint64_t m_bytes;          /**< Показание счётчика объёма на входе */
+};
+
+/**
+ * @brief Записывает строку в файл /proc/self/...
+ * @param path Путь
+ * @param value Содержимое
+ */
+void write_proc(char const *path, std::string const &value) {
+    int const fd = ::open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(fmt::format("Open {}: {}", path, std::strerror(errno)));
+    }
+    ssize_t const written = ::write(fd, value.data(), value.size());
+    int const error = errno;
+    ::close(fd);
+    if (written != static_cast<ssize_t>(value.size())) {
+        throw std::runtime_error(fmt::format("Write {}: {}", path, std::strerror(error)));
+    }
+}
+
+/**
+ * @brief Переводит процесс в новое пустое сетевое пространство имен
+ *
+ * Без прав root дополнительно создаётся пространство имен пользователя, в котором текущий
+ * пользователь отображается в root: этого достаточно для CAP_NET_ADMIN в новом сетевом пространстве.
+ * Вызывается до создания потоков.
+ */
+void enter_namespace() {
+    uid_t const uid = ::geteuid();
+    gid_t const gid = ::getegid();
+    if (uid == 0) {
+        if (::unshare(CLONE_NEWNET) != 0) {
+            throw std::runtime_error(fmt::format("Unshare network namespace: {}", std::strerror(errno)));
+        }
+        return;
+    }
+
+    if (::unshare(CLONE_NEWUSER | CLONE_NEWNET) != 0) {
+        throw std::runtime_error(fmt::format("Unshare user and network namespaces: {}", std::strerror(errno)));
+    }
+    write_proc("/proc/self/setgroups", "deny");
+    write_proc("/proc/self/uid_map", fmt::format("0 {} 1", uid));
+    write_proc("/proc/self/gid_map", fmt::format("0 {} 1", gid));
+}
+
+/**
+ * @brief Проверяет код возврата libnl
+ * @param error Код возврата
+ * @param what Описание операции
+ */
+void check(int const error, std::string_view const what) {
+    if (error < 0) {
+        throw std::runtime_error(fmt::format("{}: {}", what, nl_geterror(error)));
+    }
+}
+
+/**
+ * @brief Создаёт выключенный интерфейс: dummy, если модуль доступен, иначе пару veth
+ * @param sock Сокет Netlink
+ * @param name Имя интерфейса
+ * @param use_veth Признак использования veth (устанавливается при отсутствии dummy)
+ * @return Количество созданных интерфейсов (1 или 2)
+ */
+std::size_t add_link(nl_sock *sock, std::string const &name, bool &use_veth) {
+    if (!use_veth) {
+        rtnl_link *link = rtnl_link_alloc();
+        rtnl_link_set_type(link, "dummy");
+        rtnl_link_set_name(link, name.c_str());
+        int const error = rtnl_link_add(sock, link, NLM_F_CREATE | NLM_F_EXCL);
+        rtnl_link_put(link);
+        if (error >= 0) {
+            return 1;
+        }
+        use_veth = true;
+    }
+
+    rtnl_link *link = rtnl_link_veth_alloc();
+    rtnl_link *peer = rtnl_link_veth_get_peer(link);
+    rtnl_link_set_name(link, name.c_str());
+    rtnl_link_set_name(peer, fmt::format("{}p", name).c_str());
+    int const error = rtnl_link_add(sock, link, NLM_F_CREATE | NLM_F_EXCL);
+    rtnl_link_put(peer);
+    rtnl_link_veth_release(link);
+    check(error, fmt::format("Add veth {}", name));
+    return 2;
+}
+
+/**
+ * @brief Наполняет текущее пространство имен интерфейсами с адресом, маршрутом и соседом на каждом
+ *
+ * Дополнительные префиксы (--routes=N) длиной от /16 до /24 распределяются по интерфейсам по кругу.
+ * @param count Требуемое количество интерфейсов (с учётом второй половины пар veth)
+ */
+void populate(std::size_t const count) {
+    nl_sock *sock = nl_socket_alloc();
+    check(nl_connect(sock, NETLINK_ROUTE), "Connect netlink socket");
+
+    std::vector<std::string> names;
+    bool use_veth = false;
+    for (std::size_t created = 0; created < count;) {
+        names.push_back(fmt::format("bench{}", names.size()));
+        created += add_link(sock, names.back(), use_veth);
+    }
+
+    nl_cache *links = nullptr;
+    check(rtnl_link_alloc_cache(sock, AF_UNSPEC, &links), "Dump links");
+
+    // Флаги при создании veth ядро не принимает, поэтому все интерфейсы (и lo) поднимаются отдельно:
+    // маршрут через выключенный интерфейс не добавляется.
+    rtnl_link *up = rtnl_link_alloc();
+    rtnl_link_set_flags(up, IFF_UP);
+    for (nl_object *object = nl_cache_get_first(links); object != nullptr; object = nl_cache_get_next(object)) {
+        auto *link = reinterpret_cast<rtnl_link *>(object);
+        check(rtnl_link_change(sock, link, up, 0), fmt::format("Set {} up", rtnl_link_get_name(link)));
+    }
+    rtnl_link_put(up);
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        int const ifindex = rtnl_link_name2i(links, names[i].c_str());
+        unsigned const high = (i >> 8) & 0xff;
+        unsigned const low = i & 0xff;
+
+        nl_addr *local = nullptr;
+        check(nl_addr_parse(fmt::format("10.{}.{}.1/24", high, low).c_str(), AF_INET, &local), "Parse address");
+        rtnl_addr *addr = rtnl_addr_alloc();
+        rtnl_addr_set_ifindex(addr, ifindex);
+        rtnl_addr_set_local(addr, local);
+        check(rtnl_addr_add(sock, addr, 0), fmt::format("Add address to {}", names[i]));
+        rtnl_addr_put(addr);
+        nl_addr_put(local);
+
+        nl_addr *dst = nullptr;
+        check(nl_addr_parse(fmt::format("172.{}.{}.0/24", 16 + (high & 0x0f), low).c_str(), AF_INET, &dst), "Parse route");
+        rtnl_route *route = rtnl_route_alloc();
+        rtnl_nexthop *nexthop = rtnl_route_nh_alloc();
+        rtnl_route_nh_set_ifindex(nexthop, ifindex);
+        rtnl_route_add_nexthop(route, nexthop);
+        rtnl_route_set_dst(route, dst);
+        rtnl_route_set_scope(route, RT_SCOPE_LINK);
+        rtnl_route_set_table(route, RT_TABLE_MAIN);
+        rtnl_route_set_protocol(route, RTPROT_STATIC);
+        check(rtnl_route_add(sock, route, NLM_F_CREATE | NLM_F_EXCL), fmt::format("Add route via {}", names[i]));
+        rtnl_route_put(route);
+        nl_addr_put(dst);
+
+        nl_addr *neighbour_address = nullptr;
+        nl_addr *mac = nullptr;
+        check(nl_addr_parse(fmt::format("10.{}.{}.2", high, low).c_str(), AF_INET, &neighbour_address), "Parse neighbour");
+        check(nl_addr_parse(fmt::format("02:00:00:{:02x}:{:02x}:02", high, low).c_str(), AF_LLC, &mac), "Parse lladdr");
+        rtnl_neigh *neighbour = rtnl_neigh_alloc();
+        rtnl_neigh_set_ifindex(neighbour, ifindex);
+        rtnl_neigh_set_dst(neighbour, neighbour_address);
+        rtnl_neigh_set_lladdr(neighbour, mac);
+        rtnl_neigh_set_state(neighbour, NUD_PERMANENT);
+        check(rtnl_neigh_add(sock, neighbour, NLM_F_CREATE), fmt::format("Add neighbour on {}", names[i]));
+        rtnl_neigh_put(neighbour);
+        nl_addr_put(mac);
+        nl_addr_put(neighbour_address);
+    }
+
+    std::mt19937 random{42};
+    for (std::size_t i = 0; i < g_route_count; ++i) {
+        unsigned const length = 16 + random() % 9;
+        uint32_t const prefix = (0x20000000u | (random() & 0x1fffffffu)) & (~0u << (32 - length));
+        nl_addr *dst = nullptr;
+        check(nl_addr_parse(fmt::format("{}.{}.{}.{}/{}", prefix >> 24, (prefix >> 16) & 0xff, (prefix >> 8) & 0xff, prefix & 0xff, length).c_str(),
+                            AF_INET, &dst),
+              "Parse route");
+        rtnl_route *route = rtnl_route_alloc();
+        rtnl_nexthop *nexthop = rtnl_route_nh_alloc();
+        rtnl_route_nh_set_ifindex(nexthop, rtnl_link_name2i(links, names[i % names.size()].c_str()));
+        rtnl_route_add_nexthop(route, nexthop);
+        rtnl_route_set_dst(route, dst);
+        rtnl_route_set_scope(route, RT_SCOPE_LINK);
+        rtnl_route_set_table(route, RT_TABLE_MAIN);
+        rtnl_route_set_protocol(route, RTPROT_STATIC);
+        // Случайные префиксы изредка совпадают: повтор заменяет прежний маршрут.
+        check(rtnl_route_add(sock, route, NLM_F_CREATE | NLM_F_REPLACE), "Add synthetic route");
+        rtnl_route_put(route);
+        nl_addr_put(dst);
+    }
+
+    g_probe_interface = names[names.size() / 2];
+    nl_cache_free(links);
+    nl_socket_free(sock);
+}
+
+/**
+ * @brief Создаёт экземпляр над живым ядром или над дампом (--replay)
+ * @param mode Режим обновления кэшей
+ * @return Экземпляр с загруженными кэшами
+ */
+std::unique_ptr<InformerNetlink> open_informer(UpdateMode const mode) {
+    InformerOptions const options{mode, Cache::All};
+    return g_replay_path.empty() ? InformerNetlink::create(options) : InformerNetlink::create_from_dump(g_replay_path, options);
+}
+
+/**
+ * @brief Создаёт экземпляр в режиме обновления по аргументу бенчмарка
+ * @param state Состояние бенчмарка (range(0): 0 - Snapshot, 1 - Events)
+ * @return Экземпляр или nullptr, если режим недоступен при воспроизведении дампа (бенчмарк пропускается)
+ */
+std::unique_ptr<InformerNetlink> make_informer(benchmark::State &state) {
+    UpdateMode const mode = state.range(0) == 0 ? UpdateMode::Snapshot : UpdateMode::Events;
+    if (mode == UpdateMode::Events && !g_replay_path.empty()) {
+        state.SkipWithError("UpdateMode::Events requires a live kernel");
+        return nullptr;
+    }
+    return open_informer(mode);
+}
+
+/**
+ * @brief Создание экземпляра с полной загрузкой кэшей
+ */
+void BM_Create(benchmark::State &state) {
+    if (!make_informer(state)) {
+        return;
+    }
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto informer = make_informer(state);
+        benchmark::DoNotOptimize(informer);
+    }
+}
+BENCHMARK(BM_Create)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Загрузка кэша маршрутов: 0 - полный дамп, 1 - только IPv6, 2 - маршруты через один интерфейс
+ *
+ * Синтетические маршруты - IPv4, поэтому выборки 1 и 2 показывают, сколько стоит дамп, отфильтрованный
+ * ядром (InformerOptions::scope), по сравнению с полным.
+ */
+void BM_LoadRouteCache(benchmark::State &state) {
+    InformerOptions options{UpdateMode::Snapshot, Cache::Route};
+    if (state.range(0) == 1) {
+        options.scope.family = AF_INET6;
+    } else if (state.range(0) == 2) {
+        options.scope.interface = g_probe_interface;
+    }
+
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto informer = g_replay_path.empty() ? InformerNetlink::create(options) : InformerNetlink::create_from_dump(g_replay_path, options);
+        benchmark::DoNotOptimize(informer);
+    }
+}
+BENCHMARK(BM_LoadRouteCache)->ArgName("scope")->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Краткая информация обо всех интерфейсах
+ */
+void BM_GetAllInterfaces(benchmark::State &state) {
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto json = informer->get_all_interfaces();
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK(BM_GetAllInterfaces)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Полная информация обо всех интерфейсах в виде nlohmann::json
+ */
+void BM_GetAllInterfacesInfo(benchmark::State &state) {
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto json = informer->get_all_interfaces_info();
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK(BM_GetAllInterfacesInfo)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Полная информация обо всех интерфейсах в виде структур
+ */
+void BM_GetAllInterfacesData(benchmark::State &state) {
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto interfaces = informer->get_all_interfaces_data();
+        benchmark::DoNotOptimize(interfaces);
+    }
+}
+BENCHMARK(BM_GetAllInterfacesData)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Полная информация об одном интерфейсе
+ */
+void BM_GetInterfaceInfo(benchmark::State &state) {
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto json = informer->get_interface_info(g_probe_interface);
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK(BM_GetInterfaceInfo)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Выключение и включение интерфейса (два запроса за итерацию)
+ */
+void BM_DisableEnableInterface(benchmark::State &state) {
+    if (!g_replay_path.empty()) {
+        state.SkipWithError("Interface changes require a live kernel");
+        return;
+    }
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        informer->disable_interface(g_probe_interface);
+        informer->enable_interface(g_probe_interface);
+    }
+}
+BENCHMARK(BM_DisableEnableInterface)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Поиск маршрута по наибольшему совпадению префикса для случайных адресов
+ *
+ * Индекс строится до цикла измерения (первым вызовом); адреса берутся из диапазонов синтетических
+ * маршрутов, поэтому поиск доходит до глубоких узлов дерева.
+ */
+void BM_LookupRoute(benchmark::State &state) {
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+
+    std::mt19937 random{7};
+    std::vector<std::string> addresses(4096);
+    for (auto &address : addresses) {
+        uint32_t const value = random();
+        switch (value % 3) {
+            case 0:
+                address = fmt::format("{}.{}.{}.{}", 32 + ((value >> 24) & 0x1f), (value >> 16) & 0xff, (value >> 8) & 0xff, value & 0xff);
+                break;
+            case 1:
+                address = fmt::format("172.{}.{}.{}", 16 + ((value >> 16) & 0x0f), (value >> 8) & 0xff, value & 0xff);
+                break;
+            default:
+                address = fmt::format("10.{}.{}.{}", (value >> 16) & 0xff, (value >> 8) & 0xff, value & 0xff);
+        }
+    }
+    benchmark::DoNotOptimize(informer->lookup_route(addresses.front()));
+
+    std::size_t next = 0;
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto match = informer->lookup_route(addresses[next++ % addresses.size()]);
+        benchmark::DoNotOptimize(match);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (g_replay_path.empty()) {
+        state.counters["routes"] = static_cast<double>(g_interface_count + g_route_count);
+    }
+}
+BENCHMARK(BM_LookupRoute)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kNanosecond);
+
+/**
+ * @brief Поиск записи ARP/NDP по интерфейсу и адресу
+ *
+ * Пары (интерфейс, адрес) берутся из полного дампа, поэтому бенчмарк работает и при воспроизведении.
+ */
+void BM_GetNeighbour(benchmark::State &state) {
+    auto const informer = make_informer(state);
+    if (!informer) {
+        return;
+    }
+
+    std::vector<std::pair<std::string, std::string>> keys;
+    for (auto const &entry : informer->get_neighbours({})) {
+        keys.emplace_back(entry.interface, entry.neigh.ip);
+    }
+    if (keys.empty()) {
+        state.SkipWithError("No neighbours");
+        return;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{7});
+    benchmark::DoNotOptimize(informer->get_neighbour(keys.front().first, keys.front().second));
+
+    std::size_t next = 0;
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        auto const &[interface, address] = keys[next++ % keys.size()];
+        auto entry = informer->get_neighbour(interface, address);
+        benchmark::DoNotOptimize(entry);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["neighbours"] = static_cast<double>(keys.size());
+}
+BENCHMARK(BM_GetNeighbour)->ArgName("events")->Arg(0)->Arg(1)->Unit(benchmark::kNanosecond);
+
+/**
+ * @brief Выборочный дамп соседей: 0 - все записи, 1 - только FAILED/INCOMPLETE, 2 - один интерфейс
+ *
+ * Синтетические записи имеют состояние PERMANENT, поэтому выборка 1 измеряет стоимость дампа без
+ * построения объектов, а выборка 2 - дамп, отфильтрованный ядром по NDA_IFINDEX.
+ */
+void BM_GetNeighbours(benchmark::State &state) {
+    auto const informer = open_informer(UpdateMode::Snapshot);
+    NeighbourFilter filter;
+    if (state.range(0) == 1) {
+        filter.states = NUD_FAILED | NUD_INCOMPLETE;
+    } else if (state.range(0) == 2) {
+        filter.interface = g_probe_interface;
+    }
+
+    AllocationScope const scope{state};
+    std::size_t found = 0;
+    for (auto _ : state) {
+        auto entries = informer->get_neighbours(filter);
+        found = entries.size();
+        benchmark::DoNotOptimize(entries);
+    }
+    state.counters["found"] = static_cast<double>(found);
+}
+BENCHMARK(BM_GetNeighbours)->ArgName("filter")->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Сериализация реальных данных через nlohmann::json::dump()
+ */
+void BM_SerializeDump(benchmark::State &state) {
+    auto const json = open_informer(UpdateMode::Snapshot)->get_all_interfaces_info();
+    std::size_t bytes = 0;
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        std::string out = json.dump();
+        bytes += out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_SerializeDump)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Потоковая сериализация реальных данных через write_json
+ */
+void BM_SerializeStream(benchmark::State &state) {
+    auto const interfaces = open_informer(UpdateMode::Snapshot)->get_all_interfaces_data();
+    std::size_t bytes = 0;
+    AllocationScope const scope{state};
+    for (auto _ : state) {
+        std::string out;
+        write_json(out, interfaces);
+        bytes += out.size();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_SerializeStream)->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+int main(int argc, char **argv) {
+    // Собственные параметры удаляются до разбора параметров Google Benchmark.
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg = argv[i];
+        if (arg.starts_with("--interfaces=")) {
+            g_interface_count = std::strtoul(argv[i] + std::strlen("--interfaces="), nullptr, 10);
+            continue;
+        }
+        if (arg.starts_with("--routes=")) {
+            g_route_count = std::strtoul(argv[i] + std::strlen("--routes="), nullptr, 10);
+            continue;
+        }
+        if (arg.starts_with("--replay=")) {
+            g_replay_path = arg.substr(std::strlen("--replay="));
+            continue;
+        }
+        if (arg.starts_with("--record=")) {
+            g_record_path = arg.substr(std::strlen("--record="));
+            continue;
+        }
+        argv[kept++] = argv[i];
+    }
+    argc = kept;
+    if (g_interface_count == 0) {
+        std::cerr << "Error: --interfaces must be positive" << std::endl;
+        return 2;
+    }
+
+    try {
+        if (g_replay_path.empty()) {
+            enter_namespace();
+            populate(g_interface_count);
+            if (!g_record_path.empty()) {
+                record_netlink_dump(g_record_path);
+            }
+        } else {
+            // Топология берётся из дампа: пространство имен и права не нужны.
+            auto const interfaces = open_informer(UpdateMode::Snapshot)->get_all_interfaces_data(Section::General);
+            if (interfaces.empty()) {
+                throw std::runtime_error(fmt::format("{} contains no interfaces", g_replay_path));
+            }
+            g_interface_count = interfaces.size();
+            g_probe_interface = interfaces[interfaces.size() / 2].interface;
+        }
+    } catch (std::exception const &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
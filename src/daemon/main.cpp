@@ -0,0 +1,91 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <cstring>
+#include <informer/snapshot_publisher.hpp>
+#include <iostream>
+#include <string_view>
+
+#include "metrics_server.hpp"
+
+namespace {
+
+/**
+ * @brief Выводит справку по параметрам командной строки
+ * @param program Имя программы
+ */
+void print_usage(char const *program) {
+    std::cerr << "Usage: " << program << " [--socket PATH] [--interval MS] [--netns NAME]\n"
+              << "  --socket PATH   Unix socket to listen on (default /run/interface_informer.sock)\n"
+              << "  --interval MS   Counter refresh period in milliseconds (default 1000)\n"
+              << "  --netns NAME    Network namespace from /var/run/netns (default current)\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    ::os::network::ServerOptions server_options{};
+    ::os::network::PublisherOptions publisher_options{};
+    std::string netns{};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        std::string_view const value = argv[++i];
+        if (arg == "--socket") {
+            server_options.socket_path = value;
+        } else if (arg == "--interval") {
+            long interval = 0;
+            auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), interval);
+            if (error != std::errc{} || end != value.data() + value.size() || interval <= 0) {
+                std::cerr << "Error: invalid interval '" << value << "'" << std::endl;
+                return 2;
+            }
+            publisher_options.interval = std::chrono::milliseconds{interval};
+        } else if (arg == "--netns") {
+            netns = value;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    int namespace_fd = -1;
+    try {
+        if (!netns.empty()) {
+            std::string const path = "/var/run/netns/" + netns;
+            namespace_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (namespace_fd < 0) {
+                std::cerr << "Error: open " << path << ": " << std::strerror(errno) << std::endl;
+                return 1;
+            }
+            publisher_options.namespace_fd = namespace_fd;
+        }
+
+        auto const publisher = ::os::network::SnapshotPublisher::create(publisher_options);
+        // Сервер блокирует сигналы, поэтому создаётся до запуска фонового потока издателя.
+        ::os::network::MetricsServer server{server_options, *publisher};
+        publisher->start();
+        server.run();
+        publisher->stop();
+    } catch (std::exception const &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        if (namespace_fd >= 0) {
+            ::close(namespace_fd);
+        }
+        return 1;
+    }
+
+    if (namespace_fd >= 0) {
+        ::close(namespace_fd);
+    }
+    return 0;
+}
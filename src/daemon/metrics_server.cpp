@@ -0,0 +1,332 @@
+#include "metrics_server.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <informer/json_writer.hpp>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "openmetrics.hpp"
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @brief Собирает полный HTTP-ответ с заголовками
+ * @param status Строка статуса, например "200 OK"
+ * @param content_type Значение Content-Type
+ * @param body Тело ответа
+ * @return Готовый к отправке ответ
+ */
+std::shared_ptr<std::string const> make_response(std::string_view const status, std::string_view const content_type, std::string const &body) {
+    auto response = std::make_shared<std::string>();
+    response->reserve(body.size() + 160);
+    *response += ::fmt::format("HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n", status, content_type,
+                               body.size());
+    *response += body;
+    return response;
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(ServerOptions const &options, SnapshotPublisher const &publisher)
+    : m_options{options}, m_publisher{publisher} {
+    if (m_options.socket_path.size() >= sizeof(sockaddr_un::sun_path)) {
+        throw exceptions::MetricsServerEx(::fmt::format("Socket path is too long: {}", m_options.socket_path));
+    }
+
+    m_not_found_response = make_response("404 Not Found", "text/plain; charset=utf-8", "Not Found\n");
+    m_bad_method_response = make_response("405 Method Not Allowed", "text/plain; charset=utf-8", "Method Not Allowed\n");
+
+    sigset_t signals{};
+    ::sigemptyset(&signals);
+    ::sigaddset(&signals, SIGINT);
+    ::sigaddset(&signals, SIGTERM);
+    // Маску наследуют потоки, созданные позже, поэтому сервер нужно создавать до SnapshotPublisher::start():
+    // иначе сигнал может быть доставлен фоновому потоку с действием по умолчанию.
+    ::pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    ::signal(SIGPIPE, SIG_IGN);
+
+    try {
+        m_signal_fd = ::signalfd(-1, &signals, SFD_CLOEXEC | SFD_NONBLOCK);
+        if (m_signal_fd < 0) {
+            throw exceptions::MetricsServerEx(::fmt::format("Create signalfd: {}", std::strerror(errno)));
+        }
+
+        m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_listen_fd < 0) {
+            throw exceptions::MetricsServerEx(::fmt::format("Create socket: {}", std::strerror(errno)));
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, m_options.socket_path.c_str(), m_options.socket_path.size() + 1);
+        // Сокет, оставшийся после аварийного завершения, мешает bind. Удаляется только сокет, который
+        // никто не слушает: подключение к работающему экземпляру завершается успешно или с EAGAIN.
+        int const probe_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (probe_fd < 0) {
+            throw exceptions::MetricsServerEx(::fmt::format("Create socket: {}", std::strerror(errno)));
+        }
+        int const probe = ::connect(probe_fd, reinterpret_cast<sockaddr const *>(&address), sizeof(address));
+        int const probe_error = errno;
+        ::close(probe_fd);
+        if (probe == 0 || probe_error == EAGAIN) {
+            throw exceptions::MetricsServerEx(::fmt::format("Socket {} is in use by another instance", m_options.socket_path));
+        }
+        if (probe_error == ECONNREFUSED) {
+            ::unlink(m_options.socket_path.c_str());
+        }
+        if (::bind(m_listen_fd, reinterpret_cast<sockaddr const *>(&address), sizeof(address)) != 0) {
+            throw exceptions::MetricsServerEx(::fmt::format("Bind {}: {}", m_options.socket_path, std::strerror(errno)));
+        }
+        m_bound = true;
+        struct stat st{};
+        if (::stat(m_options.socket_path.c_str(), &st) == 0) {
+            m_socket_device = st.st_dev;
+            m_socket_inode = st.st_ino;
+        }
+        ::chmod(m_options.socket_path.c_str(), m_options.socket_mode);
+        if (::listen(m_listen_fd, SOMAXCONN) != 0) {
+            throw exceptions::MetricsServerEx(::fmt::format("Listen {}: {}", m_options.socket_path, std::strerror(errno)));
+        }
+
+        m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (m_epoll_fd < 0) {
+            throw exceptions::MetricsServerEx(::fmt::format("Create epoll: {}", std::strerror(errno)));
+        }
+        for (int const fd : {m_listen_fd, m_signal_fd}) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                throw exceptions::MetricsServerEx(::fmt::format("Register descriptor in epoll: {}", std::strerror(errno)));
+            }
+        }
+    } catch (...) {
+        for (int const fd : {m_epoll_fd, m_listen_fd, m_signal_fd}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        unlink_socket();
+        throw;
+    }
+}
+
+MetricsServer::~MetricsServer() {
+    for (auto const &[fd, connection] : m_connections) {
+        ::close(fd);
+    }
+    ::close(m_epoll_fd);
+    ::close(m_listen_fd);
+    ::close(m_signal_fd);
+    unlink_socket();
+}
+
+void MetricsServer::unlink_socket() const noexcept {
+    if (!m_bound) {
+        return;
+    }
+    // После завершения этого экземпляра путь мог занять другой: его сокет удалять нельзя.
+    struct stat st{};
+    if (::stat(m_options.socket_path.c_str(), &st) == 0 && st.st_dev == m_socket_device && st.st_ino == m_socket_inode) {
+        ::unlink(m_options.socket_path.c_str());
+    }
+}
+
+void MetricsServer::run() {
+    std::array<epoll_event, 64> events{};
+    while (true) {
+        int const count = ::epoll_wait(m_epoll_fd, events.data(), static_cast<int>(events.size()), 1000);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw exceptions::MetricsServerEx(::fmt::format("Wait epoll: {}", std::strerror(errno)));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int const fd = events[i].data.fd;
+            if (fd == m_signal_fd) {
+                return;
+            }
+            if (fd == m_listen_fd) {
+                accept_clients();
+                continue;
+            }
+
+            auto const it = m_connections.find(fd);
+            if (it == m_connections.end()) {
+                continue;
+            }
+            bool keep = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0 || (events[i].events & EPOLLIN) != 0;
+            if (keep && (events[i].events & EPOLLIN) != 0 && !it->second.response) {
+                keep = read_request(fd, it->second);
+            }
+            if (keep && (events[i].events & EPOLLOUT) != 0 && it->second.response) {
+                keep = write_response(fd, it->second);
+            }
+            if (!keep) {
+                close_client(fd);
+            }
+        }
+
+        expire_clients();
+    }
+}
+
+void MetricsServer::accept_clients() {
+    while (true) {
+        int const fd = ::accept4(m_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // EAGAIN - очередь пуста; остальные ошибки (EMFILE, ECONNABORTED) касаются одного соединения.
+            return;
+        }
+        if (m_connections.size() >= m_options.max_connections) {
+            ::close(fd);
+            continue;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        m_connections.emplace(fd, Connection{.deadline = std::chrono::steady_clock::now() + m_options.client_timeout});
+    }
+}
+
+bool MetricsServer::read_request(int const fd, Connection &connection) {
+    std::array<char, 4096> buffer{};
+    bool closed = false;
+    while (!closed) {
+        ssize_t const received = ::recv(fd, buffer.data(), buffer.size(), 0);
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // Клиент может закрыть запись сразу после запроса (shutdown(SHUT_WR)); ответ ему всё ещё нужен.
+        closed = received == 0;
+        connection.request.append(buffer.data(), static_cast<std::size_t>(received));
+        if (connection.request.size() > M_MAX_REQUEST_SIZE) {
+            return false;
+        }
+    }
+
+    // Тело запроса не читается: поддерживается только GET, поэтому достаточно конца заголовков.
+    if (connection.request.find("\r\n\r\n") == std::string::npos && connection.request.find("\n\n") == std::string::npos) {
+        return !closed;
+    }
+
+    connection.response = route(connection.request);
+    connection.request.clear();
+    connection.request.shrink_to_fit();
+    if (!write_response(fd, connection)) {
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLOUT;
+    event.data.fd = fd;
+    return ::epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+bool MetricsServer::write_response(int const fd, Connection &connection) {
+    std::string const &response = *connection.response;
+    while (connection.sent < response.size()) {
+        ssize_t const sent = ::send(fd, response.data() + connection.sent, response.size() - connection.sent, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        connection.sent += static_cast<std::size_t>(sent);
+    }
+    return false;
+}
+
+std::shared_ptr<std::string const> MetricsServer::route(std::string const &request) {
+    std::string_view const line{request.data(), request.find_first_of("\r\n")};
+    auto const method_end = line.find(' ');
+    if (method_end == std::string_view::npos) {
+        return m_bad_method_response;
+    }
+    std::string_view const method = line.substr(0, method_end);
+    std::string_view target = line.substr(method_end + 1);
+    target = target.substr(0, target.find(' '));
+    target = target.substr(0, target.find('?'));
+
+    if (method != "GET") {
+        return m_bad_method_response;
+    }
+
+    if (target == "/metrics") {
+        refresh_cache();
+        return m_metrics_response;
+    }
+    if (target == "/json") {
+        refresh_cache();
+        return m_json_response;
+    }
+    return m_not_found_response;
+}
+
+void MetricsServer::refresh_cache() {
+    auto const snapshot = m_publisher.get_snapshot();
+    if (m_metrics_response && snapshot->generation == m_cached_generation) {
+        return;
+    }
+
+    // Соединения, начавшие отправку, удерживают прежние буферы через shared_ptr.
+    std::string body{};
+    write_openmetrics(body, snapshot->interfaces);
+    m_metrics_response = make_response("200 OK", "application/openmetrics-text; version=1.0.0; charset=utf-8", body);
+
+    body.clear();
+    write_json(body, snapshot->interfaces, snapshot->sections);
+    m_json_response = make_response("200 OK", "application/json", body);
+
+    m_cached_generation = snapshot->generation;
+}
+
+void MetricsServer::close_client(int const fd) {
+    ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    m_connections.erase(fd);
+}
+
+void MetricsServer::expire_clients() {
+    auto const now = std::chrono::steady_clock::now();
+    for (auto it = m_connections.begin(); it != m_connections.end();) {
+        if (it->second.deadline > now) {
+            ++it;
+            continue;
+        }
+        ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->first, nullptr);
+        ::close(it->first);
+        it = m_connections.erase(it);
+    }
+}
+
+} // namespace os::network
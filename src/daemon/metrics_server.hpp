@@ -0,0 +1,143 @@
+#pragma once
+
+#include <informer/snapshot_publisher.hpp>
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace os::network {
+namespace exceptions {
+
+/**
+ * @struct MetricsServerEx
+ * @brief Исключение при ошибке создания сокета или цикла событий сервера метрик
+ */
+struct MetricsServerEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @struct ServerOptions
+ * @brief Параметры сервера метрик
+ */
+struct ServerOptions {
+    std::string socket_path{"/run/interface_informer.sock"}; /**< Путь Unix-сокета */
+    unsigned socket_mode{0660};                              /**< Права доступа к сокету */
+    std::chrono::milliseconds client_timeout{5000};          /**< Время жизни соединения без завершённого запроса */
+    std::size_t max_connections{256};                        /**< Максимальное количество одновременных соединений */
+};
+
+/**
+ * @class MetricsServer
+ * @brief Однопоточный HTTP/1.x-сервер метрик на Unix-сокете поверх epoll
+ *
+ * Обслуживает GET /metrics (OpenMetrics) и GET /json (формат get_all_interfaces_info). Ответы
+ * целиком, вместе с заголовками, хранятся готовыми буферами и перестраиваются только при появлении
+ * снимка с новым номером, поэтому обработка запроса сводится к записи буфера в сокет. Каждое
+ * соединение обслуживает один запрос.
+ */
+class MetricsServer final {
+   public:
+    /**
+     * @brief Создаёт и слушает Unix-сокет; блокирует SIGINT и SIGTERM в вызывающем потоке и принимает их через signalfd
+     * @param options Параметры сервера
+     * @param publisher Издатель снимков (должен жить дольше сервера)
+     * @throw exceptions::MetricsServerEx если не удалось создать сокет, epoll или signalfd, а также если
+     *        socket_path уже слушает другой экземпляр
+     */
+    MetricsServer(ServerOptions const &options, SnapshotPublisher const &publisher);
+    ~MetricsServer();
+
+    MetricsServer(MetricsServer const &) = delete;
+    MetricsServer(MetricsServer &&) = delete;
+    MetricsServer &operator=(MetricsServer const &) = delete;
+    MetricsServer &operator=(MetricsServer &&) = delete;
+
+    /**
+     * @brief Обслуживает соединения до получения SIGINT или SIGTERM
+     * @throw exceptions::MetricsServerEx при ошибке epoll_wait
+     */
+    void run();
+
+   private:
+    /**
+     * @struct Connection
+     * @brief Состояние клиентского соединения
+     */
+    struct Connection {
+        std::string request{};                                /**< Принятая часть запроса */
+        std::shared_ptr<std::string const> response{};        /**< Отправляемый ответ (переживает перестроение кэша) */
+        std::size_t sent{};                                   /**< Отправлено байт ответа */
+        std::chrono::steady_clock::time_point deadline{};     /**< Момент принудительного закрытия */
+    };
+
+    /**
+     * @brief Принимает все ожидающие соединения
+     */
+    void accept_clients();
+    /**
+     * @brief Читает запрос и, получив его целиком, начинает отправку ответа
+     * @param fd Дескриптор соединения
+     * @param connection Состояние соединения
+     * @return false, если соединение нужно закрыть
+     */
+    bool read_request(int fd, Connection &connection);
+    /**
+     * @brief Отправляет оставшуюся часть ответа
+     * @param fd Дескриптор соединения
+     * @param connection Состояние соединения
+     * @return false, если ответ отправлен полностью или произошла ошибка
+     */
+    bool write_response(int fd, Connection &connection);
+    /**
+     * @brief Выбирает ответ по строке запроса
+     * @param request Запрос (как минимум строка запроса)
+     * @return Готовый ответ с заголовками
+     */
+    std::shared_ptr<std::string const> route(std::string const &request);
+    /**
+     * @brief Перестраивает буферы ответов, если опубликован новый снимок
+     */
+    void refresh_cache();
+    /**
+     * @brief Закрывает соединение и удаляет его из epoll
+     * @param fd Дескриптор соединения
+     */
+    void close_client(int fd);
+    /**
+     * @brief Закрывает соединения с истёкшим временем жизни
+     */
+    void expire_clients();
+    /**
+     * @brief Удаляет файл сокета, если путь по-прежнему указывает на сокет этого экземпляра
+     */
+    void unlink_socket() const noexcept;
+
+    /**
+     * @brief Максимальный размер заголовков запроса
+     */
+    static constexpr std::size_t M_MAX_REQUEST_SIZE = 8192;
+
+    ServerOptions m_options{};                                  /**< Параметры сервера */
+    SnapshotPublisher const &m_publisher;                       /**< Источник снимков */
+    int m_listen_fd{-1};                                        /**< Слушающий сокет */
+    int m_epoll_fd{-1};                                         /**< Дескриптор epoll */
+    int m_signal_fd{-1};                                        /**< signalfd для SIGINT и SIGTERM */
+    bool m_bound{false};                                        /**< Файл сокета создан этим экземпляром */
+    dev_t m_socket_device{};                                    /**< Устройство файла сокета */
+    ino_t m_socket_inode{};                                     /**< Inode файла сокета */
+    std::unordered_map<int, Connection> m_connections{};        /**< Соединения по дескриптору */
+    uint64_t m_cached_generation{};                             /**< Номер снимка, по которому построены ответы */
+    std::shared_ptr<std::string const> m_metrics_response{};    /**< Ответ GET /metrics */
+    std::shared_ptr<std::string const> m_json_response{};       /**< Ответ GET /json */
+    std::shared_ptr<std::string const> m_not_found_response{};  /**< Ответ 404 */
+    std::shared_ptr<std::string const> m_bad_method_response{}; /**< Ответ 405 */
+};
+
+} // namespace os::network
@@ -0,0 +1,112 @@
+#include "openmetrics.hpp"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <string_view>
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @struct CounterFamily
+ * @brief Семейство счётчиков трафика
+ */
+struct CounterFamily {
+    char const *name;             /**< Имя семейства без суффикса _total */
+    char const *help;             /**< Описание */
+    bool rx;                      /**< true - статистика приёма, false - передачи */
+    uint64_t Packetometr::*field; /**< Поле статистики */
+};
+
+constexpr CounterFamily M_COUNTERS[] = {
+    {"interface_receive_bytes", "Received bytes.", true, &Packetometr::bytes},
+    {"interface_receive_packets", "Received packets.", true, &Packetometr::packets},
+    {"interface_receive_errors", "Receive errors.", true, &Packetometr::errors},
+    {"interface_receive_drops", "Dropped received packets.", true, &Packetometr::drops},
+    {"interface_transmit_bytes", "Transmitted bytes.", false, &Packetometr::bytes},
+    {"interface_transmit_packets", "Transmitted packets.", false, &Packetometr::packets},
+    {"interface_transmit_errors", "Transmit errors.", false, &Packetometr::errors},
+    {"interface_transmit_drops", "Dropped transmitted packets.", false, &Packetometr::drops},
+};
+
+/**
+ * @brief Дописывает значение метки с экранированием обратной косой черты, кавычки и перевода строки
+ * @param out Строка, в конец которой выполняется запись
+ * @param value Значение метки
+ */
+void append_label_value(std::string &out, std::string const &value) {
+    for (char const c : value) {
+        switch (c) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '"':
+                out += "\\\"";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                out += c;
+        }
+    }
+}
+
+/**
+ * @brief Дописывает строку образца вида name{interface="..."} value
+ * @param out Строка, в конец которой выполняется запись
+ * @param name Имя образца
+ * @param interface Имя интерфейса
+ * @param value Значение
+ */
+void append_sample(std::string &out, std::string_view const name, std::string const &interface, uint64_t const value) {
+    out += name;
+    out += "{interface=\"";
+    append_label_value(out, interface);
+    out += "\"} ";
+    out += ::fmt::format_int(value).str();
+    out += '\n';
+}
+
+} // namespace
+
+void write_openmetrics(std::string &out, std::vector<Json> const &interfaces) {
+    for (auto const &family : M_COUNTERS) {
+        out += ::fmt::format("# TYPE {} counter\n# HELP {} {}\n", family.name, family.name, family.help);
+        std::string const sample = ::fmt::format("{}_total", family.name);
+        for (auto const &interface : interfaces) {
+            Packetometr const &stats = family.rx ? interface.rx : interface.tx;
+            append_sample(out, sample, interface.interface, stats.*family.field);
+        }
+    }
+
+    out += "# TYPE interface_up gauge\n# HELP interface_up Administrative state (IFF_UP).\n";
+    for (auto const &interface : interfaces) {
+        append_sample(out, "interface_up", interface.interface, interface.general.state == "UP" ? 1 : 0);
+    }
+
+    out += "# TYPE interface_oper_up gauge\n# HELP interface_oper_up Operational state is UP.\n";
+    for (auto const &interface : interfaces) {
+        append_sample(out, "interface_oper_up", interface.interface, interface.operational_status.oper_state == "UP" ? 1 : 0);
+    }
+
+    out += "# TYPE interface_mtu gauge\n# HELP interface_mtu Maximum transmission unit.\n";
+    for (auto const &interface : interfaces) {
+        append_sample(out, "interface_mtu", interface.interface, interface.hw.mtu);
+    }
+
+    out += "# TYPE interface info\n# HELP interface Interface index and operational state.\n";
+    for (auto const &interface : interfaces) {
+        out += "interface_info{interface=\"";
+        append_label_value(out, interface.interface);
+        out += ::fmt::format("\",ifindex=\"{}\",oper_state=\"", interface.general.index);
+        append_label_value(out, interface.operational_status.oper_state);
+        out += "\"} 1\n";
+    }
+
+    out += "# EOF\n";
+}
+
+} // namespace os::network
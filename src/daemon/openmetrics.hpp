@@ -0,0 +1,19 @@
+#pragma once
+
+#include <informer/interface_info.hpp>
+#include <string>
+#include <vector>
+
+namespace os::network {
+
+/**
+ * @brief Дописывает счётчики и состояние интерфейсов в текстовом формате OpenMetrics
+ *
+ * Для каждого интерфейса выводятся счётчики приёма и передачи (байты, пакеты, ошибки, отброшенные
+ * пакеты), административное и операционное состояние и MTU. Вывод завершается строкой "# EOF".
+ * @param out Строка, в конец которой выполняется запись
+ * @param interfaces Информация об интерфейсах (нужны секции general, hw, operational_status, rx, tx)
+ */
+void write_openmetrics(std::string &out, std::vector<Json> const &interfaces);
+
+} // namespace os::network
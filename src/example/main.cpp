@@ -13,10 +13,8 @@ int main() {
         auto const all_interfaces = connection->get_all_interfaces();
         std::cout << all_interfaces.dump(4) << std::endl << std::endl;
 
-        std::cout << "Switch to namespace 'sample'!" << std::endl;
-        ::os::network::InformerNetlink::switch_to_namespace("sample");
         std::cout << "All interfaces namespace 'sample':\n";
-        auto const connection_sample = ::os::network::InformerNetlink::create();
+        auto const connection_sample = ::os::network::InformerNetlink::create_in_namespace("sample");
         auto const all_interfaces_sample = connection_sample->get_all_interfaces();
         std::cout << all_interfaces_sample.dump(4) << std::endl << std::endl;
 
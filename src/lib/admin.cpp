@@ -0,0 +1,288 @@
+#include "admin.hpp"
+
+#include <fmt/format.h>
+#include <linux/if.h>
+#include <linux/rtnetlink.h>
+#include <netlink/attr.h>
+#include <netlink/msg.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <optional>
+
+#include "namespace_guard.hpp"
+
+namespace os::network {
+
+InterfaceAdmin *InterfaceAdmin::create(AdminOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new PipelinedInterfaceAdmin(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+PipelinedInterfaceAdmin::PipelinedInterfaceAdmin(AdminOptions const &options) : m_max_in_flight{options.max_in_flight} {
+    if (m_max_in_flight == 0) {
+        throw exceptions::AdminEx("Admin max_in_flight must be positive");
+    }
+
+    {
+        std::optional<NetNamespaceGuard> guard;
+        if (options.namespace_fd >= 0) {
+            guard.emplace(options.namespace_fd);
+        }
+
+        m_socket.reset(nl_socket_alloc());
+        if (!m_socket) {
+            throw exceptions::AllocateSocket("Allocate netlink socket");
+        }
+        if (nl_connect(m_socket.get(), NETLINK_ROUTE) < 0) {
+            throw exceptions::ConnectNetlinkRoute("Connect to NETLINK_ROUTE");
+        }
+    }
+
+    // Подтверждения всех запросов в полёте должны поместиться в приёмный буфер, иначе ядро их отбросит.
+    // Ядро ограничивает размер значением net.core.rmem_max.
+    int const receive_buffer = static_cast<int>(std::min<std::size_t>(m_max_in_flight * M_ACK_BUFFER_BYTES, 1u << 24));
+    nl_socket_set_buffer_size(m_socket.get(), std::max(receive_buffer, 32768), 0);
+    nl_socket_set_nonblocking(m_socket.get());
+
+    m_callbacks.reset(nl_cb_alloc(NL_CB_DEFAULT));
+    if (!m_callbacks) {
+        throw exceptions::AdminEx("Allocate netlink callbacks");
+    }
+    nl_cb_set(m_callbacks.get(), NL_CB_ACK, NL_CB_CUSTOM, on_ack, this);
+    nl_cb_err(m_callbacks.get(), NL_CB_CUSTOM, on_error, this);
+    // Порядковые номера сверяются со списком отправленных запросов: после потери подтверждений
+    // строгая проверка libnl отвергала бы все последующие.
+    nl_cb_set(m_callbacks.get(), NL_CB_SEQ_CHECK, NL_CB_CUSTOM, [](nl_msg *, void *) { return static_cast<int>(NL_OK); }, nullptr);
+
+    m_wake_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_wake_fd < 0) {
+        throw exceptions::AdminEx(::fmt::format("Create eventfd: {}", std::strerror(errno)));
+    }
+
+    m_thread = std::jthread([this] { run(); });
+}
+
+PipelinedInterfaceAdmin::~PipelinedInterfaceAdmin() {
+    {
+        std::lock_guard const lock(m_queue_mutex);
+        m_stopping = true;
+    }
+    if (wake() != 0) {
+        // Без пробуждения служебный поток не выйдет из poll, и ожидание его завершения зависло бы навсегда.
+        std::terminate();
+    }
+    m_thread.join();
+
+    ::close(m_wake_fd);
+}
+
+std::future<InterfaceChangeResult> PipelinedInterfaceAdmin::set_interface_state(InterfaceStateChange const &change) {
+    auto promise = std::make_shared<std::promise<InterfaceChangeResult>>();
+    auto future = promise->get_future();
+    set_interface_state(change, [promise](InterfaceChangeResult const &result) { promise->set_value(result); });
+    return future;
+}
+
+void PipelinedInterfaceAdmin::set_interface_state(InterfaceStateChange const &change, InterfaceChangeCallback callback) {
+    uint64_t id = 0;
+    {
+        std::lock_guard const lock(m_queue_mutex);
+        if (!m_stopping) {
+            id = ++m_next_id;
+            m_queue.push_back({change, std::move(callback), id});
+            callback = nullptr;
+        }
+    }
+
+    if (callback) {
+        Request request{change, std::move(callback)};
+        complete(request, ECANCELED, "объект управления интерфейсами разрушается");
+        return;
+    }
+
+    if (int const error = wake(); error != 0) {
+        // Операция, которую служебный поток ещё не взял из очереди, возвращается вызывающему исключением,
+        // чтобы обработчик не остался без вызова; взятая операция завершится обычным образом.
+        std::lock_guard const lock(m_queue_mutex);
+        auto const it = std::find_if(m_queue.begin(), m_queue.end(), [id](Request const &request) { return request.id == id; });
+        if (it != m_queue.end()) {
+            m_queue.erase(it);
+            throw exceptions::AdminEx(::fmt::format("Wake admin thread: {}", std::strerror(error)));
+        }
+    }
+}
+
+int PipelinedInterfaceAdmin::wake() const noexcept {
+    uint64_t const one = 1;
+    while (::write(m_wake_fd, &one, sizeof(one)) < 0) {
+        if (errno == EAGAIN) {
+            // Счётчик eventfd у предела, то есть дескриптор уже готов к чтению и поток будет разбужен.
+            return 0;
+        }
+        if (errno != EINTR) {
+            return errno;
+        }
+    }
+    return 0;
+}
+
+void PipelinedInterfaceAdmin::run() {
+    for (;;) {
+        pollfd fds[2] = {{m_wake_fd, POLLIN, 0}, {nl_socket_get_fd(m_socket.get()), POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0 && errno != EINTR) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            uint64_t counter = 0;
+            ::read(m_wake_fd, &counter, sizeof(counter));
+        }
+        if (fds[1].revents & (POLLIN | POLLERR)) {
+            receive_acks();
+        }
+
+        {
+            std::lock_guard const lock(m_queue_mutex);
+            if (m_stopping) {
+                break;
+            }
+        }
+        send_queued();
+    }
+
+    // Ядро обрабатывает запрос в контексте sendmsg, поэтому подтверждения отправленных запросов уже в буфере
+    // и разбираются все до завершения оставшихся операций с ECANCELED.
+    receive_acks();
+    fail_pending(ECANCELED, "объект управления интерфейсами разрушен");
+
+    std::deque<Request> queue;
+    {
+        std::lock_guard const lock(m_queue_mutex);
+        queue.swap(m_queue);
+    }
+    for (auto &request : queue) {
+        complete(request, ECANCELED, "объект управления интерфейсами разрушен");
+    }
+}
+
+void PipelinedInterfaceAdmin::send_queued() {
+    std::vector<Request> batch;
+    {
+        std::lock_guard const lock(m_queue_mutex);
+        while (!m_queue.empty() && m_in_flight.size() + batch.size() < m_max_in_flight) {
+            batch.push_back(std::move(m_queue.front()));
+            m_queue.pop_front();
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+    m_buffer.clear();
+    std::vector<uint32_t> sequences;
+    sequences.reserve(batch.size());
+    for (auto &request : batch) {
+        std::unique_ptr<nl_msg, decltype(&nlmsg_free)> const msg{nlmsg_alloc_simple(RTM_SETLINK, NLM_F_ACK), nlmsg_free};
+
+        // Интерфейс ищется ядром по IFLA_IFNAME (ifi_index == 0), поэтому кэш интерфейсов не нужен.
+        ifinfomsg info{};
+        info.ifi_family = AF_UNSPEC;
+        info.ifi_change = IFF_UP;
+        info.ifi_flags = request.change.up ? IFF_UP : 0;
+        if (!msg || nlmsg_append(msg.get(), &info, sizeof(info), NLMSG_ALIGNTO) < 0 ||
+            nla_put_string(msg.get(), IFLA_IFNAME, request.change.interface_name.c_str()) < 0) {
+            complete(request, ENOMEM, "не удалось сформировать запрос");
+            continue;
+        }
+
+        nl_complete_msg(m_socket.get(), msg.get());
+        nlmsghdr const *const header = nlmsg_hdr(msg.get());
+        auto const *const bytes = reinterpret_cast<char const *>(header);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + NLMSG_ALIGN(header->nlmsg_len));
+        sequences.push_back(header->nlmsg_seq);
+        m_in_flight.emplace(header->nlmsg_seq, std::move(request));
+    }
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    if (int const ret = nl_sendto(m_socket.get(), m_buffer.data(), m_buffer.size()); ret < 0) {
+        std::string const reason = ::fmt::format("не удалось отправить запрос: {}", nl_geterror(ret));
+        for (auto const seq : sequences) {
+            if (auto const it = m_in_flight.find(seq); it != m_in_flight.end()) {
+                complete(it->second, EIO, reason);
+                m_in_flight.erase(it);
+            }
+        }
+    }
+}
+
+void PipelinedInterfaceAdmin::receive_acks() {
+    // Каждое подтверждение приходит отдельной датаграммой, а nl_recvmsgs разбирает одну датаграмму
+    // за вызов, поэтому чтение продолжается до опустошения буфера.
+    while (!m_in_flight.empty()) {
+        int const ret = nl_recvmsgs(m_socket.get(), m_callbacks.get());
+        if (ret == -NLE_AGAIN) {
+            return;
+        }
+        if (ret < 0) {
+            // Переполнение приёмного буфера (ENOBUFS): часть подтверждений потеряна, и узнать, какие
+            // именно запросы применены, уже нельзя.
+            fail_pending(ret == -NLE_NOMEM ? ENOBUFS : EIO, ::fmt::format("подтверждение не получено: {}", nl_geterror(ret)));
+            return;
+        }
+    }
+}
+
+void PipelinedInterfaceAdmin::fail_pending(int const error, std::string const &reason) {
+    for (auto &[seq, request] : m_in_flight) {
+        complete(request, error, reason);
+    }
+    m_in_flight.clear();
+}
+
+void PipelinedInterfaceAdmin::complete(Request &request, int const error, std::string const &reason) {
+    InterfaceChangeResult result{request.change.interface_name, error, {}};
+    if (error != 0) {
+        result.message = ::fmt::format("Не удалось {} интерфейс {}: {}", request.change.up ? "включить" : "выключить",
+                                       request.change.interface_name, reason);
+    }
+
+    try {
+        request.callback(result);
+    } catch (...) {
+        // Исключение обработчика не должно останавливать служебный поток и остальные операции.
+    }
+}
+
+int PipelinedInterfaceAdmin::on_ack(nl_msg *msg, void *data) {
+    static_cast<PipelinedInterfaceAdmin *>(data)->finish(nlmsg_hdr(msg)->nlmsg_seq, 0);
+    return NL_OK;
+}
+
+int PipelinedInterfaceAdmin::on_error(sockaddr_nl *, nlmsgerr *error, void *data) {
+    static_cast<PipelinedInterfaceAdmin *>(data)->finish(error->msg.nlmsg_seq, -error->error);
+    return NL_SKIP;
+}
+
+void PipelinedInterfaceAdmin::finish(uint32_t const seq, int const error) {
+    auto const it = m_in_flight.find(seq);
+    if (it == m_in_flight.end()) {
+        return;
+    }
+
+    complete(it->second, error, error != 0 ? std::strerror(error) : std::string{});
+    m_in_flight.erase(it);
+}
+
+} // namespace os::network
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <netlink/handlers.h>
+#include <netlink/netlink.h>
+#include <netlink/socket.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "informer/interface_admin.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct AdminEx
+ * @brief Исключение при ошибке инициализации асинхронного управления интерфейсами
+ */
+struct AdminEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @class PipelinedInterfaceAdmin
+ * @brief Реализация InterfaceAdmin с очередью запросов и служебным потоком, владеющим сокетом Netlink
+ */
+class PipelinedInterfaceAdmin final : public InterfaceAdmin {
+   public:
+    /**
+     * @brief Конструктор, открывающий сокет NETLINK_ROUTE и запускающий служебный поток
+     * @param options Параметры
+     * @throw exceptions::AdminEx если параметры некорректны или не удалось создать сокет или eventfd
+     */
+    explicit PipelinedInterfaceAdmin(AdminOptions const &options);
+    ~PipelinedInterfaceAdmin() override;
+
+    PipelinedInterfaceAdmin(PipelinedInterfaceAdmin const &) = delete;
+    PipelinedInterfaceAdmin(PipelinedInterfaceAdmin &&) = delete;
+    PipelinedInterfaceAdmin &operator=(PipelinedInterfaceAdmin const &) = delete;
+    PipelinedInterfaceAdmin &operator=(PipelinedInterfaceAdmin &&) = delete;
+
+    std::future<InterfaceChangeResult> set_interface_state(InterfaceStateChange const &change) override;
+    /**
+     * @brief Ставит операцию в очередь и пробуждает служебный поток
+     * @param change Интерфейс и требуемое состояние
+     * @param callback Обработчик завершения
+     * @throw exceptions::AdminEx если служебный поток не удалось разбудить (операция удаляется из очереди)
+     */
+    void set_interface_state(InterfaceStateChange const &change, InterfaceChangeCallback callback) override;
+
+   private:
+    /**
+     * @struct Request
+     * @brief Операция, ожидающая отправки или подтверждения
+     */
+    struct Request {
+        InterfaceStateChange change{};      /**< Интерфейс и требуемое состояние */
+        InterfaceChangeCallback callback{}; /**< Обработчик завершения */
+        uint64_t id{};                      /**< Номер операции в очереди */
+    };
+
+    /**
+     * @brief Пробуждает служебный поток записью в eventfd
+     * @return 0 или код errno
+     */
+    int wake() const noexcept;
+    /**
+     * @brief Тело служебного потока
+     */
+    void run();
+    /**
+     * @brief Отправляет запросы из очереди одним системным вызовом, пока не исчерпан лимит ожидающих подтверждения
+     */
+    void send_queued();
+    /**
+     * @brief Разбирает все полученные подтверждения без блокировки
+     */
+    void receive_acks();
+    /**
+     * @brief Завершает все ожидающие подтверждения операции с ошибкой
+     * @param error Код errno
+     * @param reason Описание причины
+     */
+    void fail_pending(int error, std::string const &reason);
+    /**
+     * @brief Вызывает обработчик завершения операции
+     * @param request Операция
+     * @param error 0 или код errno
+     * @param reason Описание ошибки
+     */
+    static void complete(Request &request, int error, std::string const &reason);
+    /**
+     * @brief Обработчик подтверждения (NLMSG_ERROR с нулевым кодом)
+     * @param msg Сообщение подтверждения
+     * @param data Указатель на экземпляр PipelinedInterfaceAdmin
+     * @return NL_OK
+     */
+    static int on_ack(nl_msg *msg, void *data);
+    /**
+     * @brief Обработчик ошибки ядра
+     * @param error Сообщение об ошибке с заголовком исходного запроса
+     * @param data Указатель на экземпляр PipelinedInterfaceAdmin
+     * @return NL_SKIP
+     */
+    static int on_error(sockaddr_nl *, nlmsgerr *error, void *data);
+    /**
+     * @brief Завершает операцию по порядковому номеру запроса
+     * @param seq Порядковый номер
+     * @param error 0 или код errno
+     */
+    void finish(uint32_t seq, int error);
+
+    /**
+     * @brief Приблизительный объём приёмного буфера, занимаемый одним подтверждением
+     */
+    static constexpr int M_ACK_BUFFER_BYTES = 2048;
+
+    std::size_t m_max_in_flight{};                                                         /**< Лимит запросов, ожидающих подтверждения */
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> m_socket{nullptr, nl_socket_free}; /**< Неблокирующий сокет (только служебный поток) */
+    std::unique_ptr<nl_cb, decltype(&nl_cb_put)> m_callbacks{nullptr, nl_cb_put};          /**< Обработчики подтверждений */
+    int m_wake_fd{-1};                                                                     /**< eventfd для пробуждения служебного потока */
+    std::mutex m_queue_mutex{};                                                            /**< Защита очереди и признака остановки */
+    std::deque<Request> m_queue{};                                                         /**< Операции, ожидающие отправки */
+    uint64_t m_next_id{};                                                                  /**< Номер последней операции, поставленной в очередь */
+    bool m_stopping{false};                                                                /**< Признак остановки */
+    std::unordered_map<uint32_t, Request> m_in_flight{};                                   /**< Отправленные операции по порядковому номеру */
+    std::vector<char> m_buffer{};                                                          /**< Буфер пачки сообщений */
+    std::jthread m_thread{};                                                               /**< Служебный поток */
+};
+
+} // namespace os::network
@@ -0,0 +1,53 @@
+#include "collector.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace os::network {
+
+NamespaceCollector *NamespaceCollector::create(CollectorOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new ThreadedNamespaceCollector(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+ThreadedNamespaceCollector::ThreadedNamespaceCollector(CollectorOptions const &options)
+    : m_workers{options.workers != 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency())} {}
+
+std::vector<NamespaceSnapshot> ThreadedNamespaceCollector::collect(std::vector<std::string> const &namespaces, Section const sections) {
+    std::vector<NamespaceSnapshot> snapshots(namespaces.size());
+    std::atomic<std::size_t> next{0};
+
+    // Пространства имен раздаются по одному: время сбора сильно зависит от числа интерфейсов,
+    // поэтому статическое деление списка на части давало бы неравномерную загрузку потоков.
+    auto const worker = [&] {
+        for (std::size_t i = next.fetch_add(1); i < namespaces.size(); i = next.fetch_add(1)) {
+            collect_one(namespaces[i], sections, snapshots[i]);
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(std::min(m_workers, namespaces.size()));
+        for (std::size_t i = 0; i < std::min(m_workers, namespaces.size()); ++i) {
+            threads.emplace_back(worker);
+        }
+    }
+    return snapshots;
+}
+
+void ThreadedNamespaceCollector::collect_one(std::string const &name, Section const sections, NamespaceSnapshot &snapshot) {
+    snapshot.name = name;
+    try {
+        auto const informer = InformerNetlink::create_in_namespace(name, {UpdateMode::Snapshot, required_caches(sections)});
+        snapshot.interfaces = informer->get_all_interfaces_data(sections);
+    } catch (std::exception const &ex) {
+        snapshot.error = ex.what();
+    }
+}
+
+} // namespace os::network
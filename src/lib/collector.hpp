@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "informer/namespace_collector.hpp"
+
+namespace os::network {
+
+/**
+ * @class ThreadedNamespaceCollector
+ * @brief Реализация NamespaceCollector на рабочих потоках
+ *
+ * Потоки создаются на время каждого вызова collect() и берут пространства имен по одному через общий
+ * атомарный счётчик, поэтому медленное пространство имен не задерживает остальную часть списка.
+ */
+class ThreadedNamespaceCollector final : public NamespaceCollector {
+   public:
+    /**
+     * @brief Конструктор
+     * @param options Параметры сборщика
+     */
+    explicit ThreadedNamespaceCollector(CollectorOptions const &options);
+    ~ThreadedNamespaceCollector() override = default;
+
+    ThreadedNamespaceCollector(ThreadedNamespaceCollector const &) = delete;
+    ThreadedNamespaceCollector(ThreadedNamespaceCollector &&) = delete;
+    ThreadedNamespaceCollector &operator=(ThreadedNamespaceCollector const &) = delete;
+    ThreadedNamespaceCollector &operator=(ThreadedNamespaceCollector &&) = delete;
+
+    std::vector<NamespaceSnapshot> collect(std::vector<std::string> const &namespaces, Section sections = Section::All) override;
+
+   private:
+    /**
+     * @brief Снимает данные одного пространства имен в текущем потоке
+     * @param name Имя пространства имен
+     * @param sections Маска собираемых секций
+     * @param snapshot Снимок для заполнения
+     */
+    static void collect_one(std::string const &name, Section sections, NamespaceSnapshot &snapshot);
+
+    std::size_t m_workers{}; /**< Максимальное количество рабочих потоков одного вызова collect() */
+};
+
+} // namespace os::network
@@ -0,0 +1,257 @@
+#include "data_source.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <linux/if_addr.h>
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <netlink/attr.h>
+#include <netlink/msg.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "informer/netlink_dump.hpp"
+
+namespace os::network {
+
+NetlinkDataSource::NetlinkDataSource() : m_socket{nl_socket_alloc(), nl_socket_free}, m_dump_socket{nl_socket_alloc(), nl_socket_free} {
+    if (!m_socket || !m_dump_socket) {
+        throw exceptions::AllocateSocket("Allocate netlink socket");
+    }
+
+    if (nl_connect(m_socket.get(), NETLINK_ROUTE) < 0 || nl_connect(m_dump_socket.get(), NETLINK_ROUTE) < 0) {
+        throw exceptions::ConnectNetlinkRoute("Connect to NETLINK_ROUTE");
+    }
+
+    // Ядра до 4.20 не знают NETLINK_GET_STRICT_CHK и игнорируют условия запроса; ошибка не критична,
+    // так как получатели дампа проверяют условия сами.
+    int const strict = 1;
+    ::setsockopt(nl_socket_get_fd(m_dump_socket.get()), SOL_NETLINK, NETLINK_GET_STRICT_CHK, &strict, sizeof(strict));
+}
+nl_msg *NetlinkDataSource::dump_request(Cache const kind, DumpFilter const &filter) {
+    nl_msg *msg = nullptr;
+    int ret = 0;
+
+    // При строгой проверке ядро требует полный заголовок с нулевыми полями, кроме полей-фильтров.
+    switch (kind) {
+        case Cache::Addr: {
+            ifaddrmsg header{};
+            header.ifa_family = static_cast<unsigned char>(filter.family);
+            header.ifa_index = static_cast<uint32_t>(filter.ifindex);
+            msg = nlmsg_alloc_simple(RTM_GETADDR, NLM_F_DUMP);
+            ret = msg == nullptr ? -NLE_NOMEM : nlmsg_append(msg, &header, sizeof(header), NLMSG_ALIGNTO);
+            break;
+        }
+        case Cache::Route: {
+            rtmsg header{};
+            header.rtm_family = static_cast<unsigned char>(filter.family);
+            header.rtm_table = filter.table < 256 ? static_cast<unsigned char>(filter.table) : static_cast<unsigned char>(RT_TABLE_UNSPEC);
+            msg = nlmsg_alloc_simple(RTM_GETROUTE, NLM_F_DUMP);
+            ret = msg == nullptr ? -NLE_NOMEM : nlmsg_append(msg, &header, sizeof(header), NLMSG_ALIGNTO);
+            if (ret == 0 && filter.table != 0) {
+                ret = nla_put_u32(msg, RTA_TABLE, filter.table);
+            }
+            if (ret == 0 && filter.ifindex != 0) {
+                ret = nla_put_u32(msg, RTA_OIF, static_cast<uint32_t>(filter.ifindex));
+            }
+            break;
+        }
+        case Cache::Neigh: {
+            // Ядро фильтрует дамп соседей только по NDA_IFINDEX и NDA_MASTER; ndm_state в запросе не учитывается.
+            ndmsg header{};
+            header.ndm_family = static_cast<unsigned char>(filter.family);
+            msg = nlmsg_alloc_simple(RTM_GETNEIGH, NLM_F_DUMP);
+            ret = msg == nullptr ? -NLE_NOMEM : nlmsg_append(msg, &header, sizeof(header), NLMSG_ALIGNTO);
+            if (ret == 0 && filter.ifindex != 0) {
+                ret = nla_put_u32(msg, NDA_IFINDEX, static_cast<uint32_t>(filter.ifindex));
+            }
+            break;
+        }
+        default:
+            return nullptr;
+    }
+
+    if (ret < 0) {
+        nlmsg_free(msg);
+        return nullptr;
+    }
+    return msg;
+}
+int NetlinkDataSource::fill(Cache const kind, nl_cache *cache, DumpFilter const &filter) {
+    if ((kind != Cache::Addr && kind != Cache::Route) || filter.empty()) {
+        return nl_cache_refill(m_socket.get(), cache);
+    }
+
+    // Ответ разбирается тем же кэшем, что и при nl_cache_refill, включая повтор прерванного дампа.
+    int ret = 0;
+    do {
+        std::unique_ptr<nl_msg, decltype(&nlmsg_free)> msg{dump_request(kind, filter), nlmsg_free};
+        if (!msg) {
+            return -NLE_NOMEM;
+        }
+        nl_cache_clear(cache);
+        ret = nl_send_auto(m_dump_socket.get(), msg.get());
+        if (ret >= 0) {
+            ret = nl_cache_pickup(m_dump_socket.get(), cache);
+        }
+    } while (ret == -NLE_DUMP_INTR);
+    return ret < 0 ? ret : 0;
+}
+int NetlinkDataSource::dump(Cache const kind, DumpFilter const &filter, nl_recvmsg_msg_cb_t callback, void *data) {
+    if (kind != Cache::Addr && kind != Cache::Route && kind != Cache::Neigh) {
+        return -NLE_OPNOTSUPP;
+    }
+    std::unique_ptr<nl_msg, decltype(&nlmsg_free)> msg{dump_request(kind, filter), nlmsg_free};
+    if (!msg) {
+        return -NLE_NOMEM;
+    }
+
+    // Обработчики сокета не изменяются: дамп получает собственную копию с обработчиком NL_CB_VALID.
+    nl_cb *const socket_cb = nl_socket_get_cb(m_dump_socket.get());
+    std::unique_ptr<nl_cb, decltype(&nl_cb_put)> cb{nl_cb_clone(socket_cb), nl_cb_put};
+    nl_cb_put(socket_cb);
+    if (!cb) {
+        return -NLE_NOMEM;
+    }
+    nl_cb_set(cb.get(), NL_CB_VALID, NL_CB_CUSTOM, callback, data);
+
+    int ret = nl_send_auto(m_dump_socket.get(), msg.get());
+    if (ret < 0) {
+        return ret;
+    }
+    ret = nl_recvmsgs(m_dump_socket.get(), cb.get());
+    return ret < 0 ? ret : 0;
+}
+nl_sock *NetlinkDataSource::control_socket() const noexcept {
+    return m_socket.get();
+}
+
+ReplayDataSource::ReplayDataSource(std::string const &path) {
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("Open {}: {}", path, std::strerror(errno)));
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0) {
+        int const error = errno;
+        ::close(fd);
+        throw exceptions::NetlinkDumpEx(::fmt::format("Stat {}: {}", path, std::strerror(error)));
+    }
+
+    m_data.resize(static_cast<std::size_t>(info.st_size));
+    std::size_t offset = 0;
+    while (offset < m_data.size()) {
+        ssize_t const received = ::read(fd, m_data.data() + offset, m_data.size() - offset);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            int const error = received < 0 ? errno : EIO;
+            ::close(fd);
+            throw exceptions::NetlinkDumpEx(::fmt::format("Read {}: {}", path, std::strerror(error)));
+        }
+        offset += static_cast<std::size_t>(received);
+    }
+    ::close(fd);
+
+    NetlinkDumpHeader header{};
+    if (m_data.size() < sizeof(header)) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("{} is not a netlink dump", path));
+    }
+    std::memcpy(&header, m_data.data(), sizeof(header));
+    if (header.magic != NETLINK_DUMP_MAGIC) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("{} is not a netlink dump", path));
+    }
+    if (header.version != NETLINK_DUMP_VERSION) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("{}: unsupported dump version {}", path, header.version));
+    }
+
+    // Смещения сообщений собираются один раз; сами сообщения разбираются при каждом заполнении кэша.
+    for (offset = sizeof(header); offset < m_data.size();) {
+        auto const *const message = reinterpret_cast<nlmsghdr const *>(m_data.data() + offset);
+        std::size_t const left = m_data.size() - offset;
+        if (left < sizeof(nlmsghdr) || message->nlmsg_len < sizeof(nlmsghdr) || message->nlmsg_len > left) {
+            throw exceptions::NetlinkDumpEx(::fmt::format("{}: truncated message at offset {}", path, offset));
+        }
+
+        switch (message->nlmsg_type) {
+            case RTM_NEWLINK:
+                m_link_messages.push_back(offset);
+                break;
+            case RTM_NEWADDR:
+                m_addr_messages.push_back(offset);
+                break;
+            case RTM_NEWROUTE:
+                m_route_messages.push_back(offset);
+                break;
+            case RTM_NEWNEIGH:
+                m_neigh_messages.push_back(offset);
+                break;
+            default:
+                // Прочие типы сообщений пропускаются: формат допускает их появление в будущих версиях записи.
+                break;
+        }
+        offset += NLMSG_ALIGN(message->nlmsg_len);
+    }
+}
+int ReplayDataSource::fill(Cache const kind, nl_cache *cache, DumpFilter const &) {
+    // Запись содержит полный дамп; лишние объекты удаляет получатель.
+    nl_cache_clear(cache);
+
+    for (std::size_t const offset : messages(kind)) {
+        auto *const header = reinterpret_cast<nlmsghdr *>(m_data.data() + offset);
+        nl_msg *const msg = nlmsg_convert(header);
+        if (msg == nullptr) {
+            return -NLE_NOMEM;
+        }
+        int const ret = nl_cache_parse_and_add(cache, msg);
+        nlmsg_free(msg);
+        // nl_cache_refill так же оставляет первый из объектов с совпадающим ключом (например, IPv6-маршруты
+        // ff00::/8 разных интерфейсов), поэтому повтор не считается ошибкой.
+        if (ret < 0 && ret != -NLE_EXIST) {
+            return ret;
+        }
+    }
+    return 0;
+}
+int ReplayDataSource::dump(Cache const kind, DumpFilter const &, nl_recvmsg_msg_cb_t callback, void *data) {
+    // Запись содержит полный дамп, поэтому обработчик получает все сообщения и фильтрует их сам.
+    for (std::size_t const offset : messages(kind)) {
+        auto *const header = reinterpret_cast<nlmsghdr *>(m_data.data() + offset);
+        nl_msg *const msg = nlmsg_convert(header);
+        if (msg == nullptr) {
+            return -NLE_NOMEM;
+        }
+        int const ret = callback(msg, data);
+        nlmsg_free(msg);
+        if (ret == NL_STOP) {
+            break;
+        }
+        if (ret < 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+nl_sock *ReplayDataSource::control_socket() const noexcept {
+    return nullptr;
+}
+std::vector<std::size_t> &ReplayDataSource::messages(Cache const kind) {
+    switch (kind) {
+        case Cache::Link:
+            return m_link_messages;
+        case Cache::Addr:
+            return m_addr_messages;
+        case Cache::Route:
+            return m_route_messages;
+        default:
+            return m_neigh_messages;
+    }
+}
+
+} // namespace os::network
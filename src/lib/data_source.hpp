@@ -0,0 +1,157 @@
+#pragma once
+
+#include <netlink/cache.h>
+#include <netlink/netlink.h>
+#include <netlink/socket.h>
+#include <sys/socket.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+/**
+ * @struct DumpFilter
+ * @brief Условия выборочного дампа, передаваемые ядру в запросе
+ */
+struct DumpFilter {
+    int family{AF_UNSPEC}; /**< Семейство адресов (AF_UNSPEC - все) */
+    int ifindex{};         /**< Индекс интерфейса (0 - все интерфейсы) */
+    uint32_t table{};      /**< Таблица маршрутизации (0 - все таблицы, только для маршрутов) */
+
+    /**
+     * @brief Проверяет, ограничивает ли фильтр дамп
+     * @return true, если ограничений нет
+     */
+    [[nodiscard]] bool empty() const noexcept { return family == AF_UNSPEC && ifindex == 0 && table == 0; }
+};
+
+/**
+ * @class DataSource
+ * @brief Источник данных для кэшей ShowInfoInterface в режиме UpdateMode::Snapshot
+ */
+class DataSource {
+   public:
+    DataSource() = default;
+    virtual ~DataSource() = default;
+
+    DataSource(DataSource const &) = delete;
+    DataSource(DataSource &&) = delete;
+    DataSource &operator=(DataSource const &) = delete;
+    DataSource &operator=(DataSource &&) = delete;
+
+    /**
+     * @brief Заменяет содержимое кэша актуальными объектами
+     *
+     * Как и в dump, фильтр передаётся ядру без гарантии применения: кэш может содержать и другие объекты.
+     * @param kind Вид кэша (один бит маски Cache)
+     * @param cache Кэш соответствующего вида
+     * @param filter Условия выборки (учитываются для Cache::Addr и Cache::Route)
+     * @return 0 или отрицательный код ошибки libnl
+     */
+    virtual int fill(Cache kind, nl_cache *cache, DumpFilter const &filter) = 0;
+    /**
+     * @brief Выполняет дамп без заполнения кэша, передавая каждое сообщение обработчику
+     *
+     * Источник передаёт фильтр ядру, но не гарантирует его применение (ядро может его не поддерживать,
+     * запись дампа содержит все объекты), поэтому обработчик обязан проверять условия сам.
+     * @param kind Вид данных (Cache::Addr, Cache::Route или Cache::Neigh)
+     * @param filter Условия выборки
+     * @param callback Обработчик сообщения (возвращает NL_OK, NL_SKIP или NL_STOP)
+     * @param data Аргумент обработчика
+     * @return 0 или отрицательный код ошибки libnl
+     */
+    virtual int dump(Cache kind, DumpFilter const &filter, nl_recvmsg_msg_cb_t callback, void *data) = 0;
+    /**
+     * @brief Возвращает сокет для запросов изменения интерфейсов
+     * @return Подключенный сокет NETLINK_ROUTE или nullptr, если источник доступен только для чтения
+     */
+    [[nodiscard]] virtual nl_sock *control_socket() const noexcept = 0;
+};
+
+/**
+ * @class NetlinkDataSource
+ * @brief Источник данных, выполняющий дамп через сокет NETLINK_ROUTE
+ *
+ * Сокеты привязываются к сетевому пространству имен потока, в котором создан источник. Полные дампы
+ * выполняются через сокет libnl, выборочные - через отдельный сокет со строгой проверкой запросов:
+ * запросы кэшей libnl (например, rtgenmsg для адресов) строгую проверку не проходят.
+ */
+class NetlinkDataSource final : public DataSource {
+   public:
+    /**
+     * @brief Конструктор, подключающий сокет Netlink
+     * @throw exceptions::AllocateSocket если не удалось выделить сокет Netlink
+     * @throw exceptions::ConnectNetlinkRoute если не удалось подключиться к NETLINK_ROUTE
+     */
+    NetlinkDataSource();
+    ~NetlinkDataSource() override = default;
+
+    NetlinkDataSource(NetlinkDataSource const &) = delete;
+    NetlinkDataSource(NetlinkDataSource &&) = delete;
+    NetlinkDataSource &operator=(NetlinkDataSource const &) = delete;
+    NetlinkDataSource &operator=(NetlinkDataSource &&) = delete;
+
+    int fill(Cache kind, nl_cache *cache, DumpFilter const &filter) override;
+    int dump(Cache kind, DumpFilter const &filter, nl_recvmsg_msg_cb_t callback, void *data) override;
+    [[nodiscard]] nl_sock *control_socket() const noexcept override;
+
+   private:
+    /**
+     * @brief Строит запрос выборочного дампа
+     * @param kind Вид данных (Cache::Addr, Cache::Route или Cache::Neigh)
+     * @param filter Условия выборки
+     * @return Сообщение запроса или nullptr, если вид данных не поддерживается или не хватило памяти
+     */
+    static nl_msg *dump_request(Cache kind, DumpFilter const &filter);
+
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> m_socket{nullptr, nl_socket_free};      /**< Сокет Netlink */
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> m_dump_socket{nullptr, nl_socket_free}; /**< Сокет выборочных дампов */
+};
+
+/**
+ * @class ReplayDataSource
+ * @brief Источник данных, воспроизводящий дамп из файла (см. record_netlink_dump)
+ *
+ * Файл читается один раз при создании; каждое заполнение кэша разбирает записанные сообщения заново,
+ * поэтому повторные запросы воспроизводят одну и ту же топологию.
+ */
+class ReplayDataSource final : public DataSource {
+   public:
+    /**
+     * @brief Конструктор, загружающий и проверяющий файл дампа
+     * @param path Путь к файлу дампа
+     * @throw exceptions::NetlinkDumpEx если файл не удалось прочитать или он повреждён
+     */
+    explicit ReplayDataSource(std::string const &path);
+    ~ReplayDataSource() override = default;
+
+    ReplayDataSource(ReplayDataSource const &) = delete;
+    ReplayDataSource(ReplayDataSource &&) = delete;
+    ReplayDataSource &operator=(ReplayDataSource const &) = delete;
+    ReplayDataSource &operator=(ReplayDataSource &&) = delete;
+
+    int fill(Cache kind, nl_cache *cache, DumpFilter const &filter) override;
+    int dump(Cache kind, DumpFilter const &filter, nl_recvmsg_msg_cb_t callback, void *data) override;
+    [[nodiscard]] nl_sock *control_socket() const noexcept override;
+
+   private:
+    /**
+     * @brief Возвращает список смещений сообщений для вида кэша
+     * @param kind Вид кэша (один бит маски Cache)
+     * @return Смещения сообщений в m_data
+     */
+    std::vector<std::size_t> &messages(Cache kind);
+
+    std::vector<char> m_data{};                  /**< Содержимое файла */
+    std::vector<std::size_t> m_link_messages{};  /**< Смещения RTM_NEWLINK */
+    std::vector<std::size_t> m_addr_messages{};  /**< Смещения RTM_NEWADDR */
+    std::vector<std::size_t> m_route_messages{}; /**< Смещения RTM_NEWROUTE */
+    std::vector<std::size_t> m_neigh_messages{}; /**< Смещения RTM_NEWNEIGH */
+};
+
+} // namespace os::network
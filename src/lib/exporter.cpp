@@ -0,0 +1,221 @@
+#include "exporter.hpp"
+
+#include <fmt/format.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include <cstdio>
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @brief Копирует строку в поле фиксированной длины с завершающим нулём
+ * @param target Поле
+ * @param value Строка (обрезается при необходимости)
+ */
+template <std::size_t N>
+void copy_string(char (&target)[N], std::string const &value) {
+    std::size_t const size = std::min(value.size(), N - 1);
+    std::memcpy(target, value.data(), size);
+    std::memset(target + size, 0, N - size);
+}
+
+} // namespace
+
+CounterExporter *CounterExporter::create(ExportOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new SharedMemoryCounterExporter(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+SharedMemoryCounterExporter::SharedMemoryCounterExporter(ExportOptions const &options) : m_options{options} {
+    if (m_options.interval.count() <= 0) {
+        throw exceptions::CounterExportEx("Export interval must be positive");
+    }
+    if (m_options.capacity == 0 || m_options.capacity > UINT32_MAX) {
+        throw exceptions::CounterExportEx("Export capacity is out of range");
+    }
+
+    InformerOptions const informer_options{UpdateMode::Snapshot, Cache::Link};
+    m_informer = m_options.namespace_fd >= 0 ? InformerNetlink::create_in_namespace(m_options.namespace_fd, informer_options)
+                                             : InformerNetlink::create(informer_options);
+    m_slots.reserve(m_options.capacity);
+
+    m_stop_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_stop_fd < 0) {
+        throw exceptions::CounterExportEx(::fmt::format("Create eventfd: {}", std::strerror(errno)));
+    }
+
+    try {
+        create_file();
+        publish();
+    } catch (...) {
+        ::close(m_stop_fd);
+        if (m_memory) {
+            ::munmap(m_memory, m_size);
+            unlink_file();
+        }
+        throw;
+    }
+}
+
+SharedMemoryCounterExporter::~SharedMemoryCounterExporter() {
+    stop();
+    ::close(m_stop_fd);
+    ::munmap(m_memory, m_size);
+    // Уже открытые читатели сохраняют отображение; новые не должны подключаться к устаревшим данным.
+    unlink_file();
+}
+
+void SharedMemoryCounterExporter::create_file() {
+    m_size = sizeof(SharedCountersHeader) + m_options.capacity * sizeof(SharedInterfaceCounters);
+
+    // Файл готовится под временным именем и заменяет прежний целиком, поэтому читатель никогда
+    // не увидит файл без заголовка или меньшего размера. Уникальное имя не даёт двум экземплярам
+    // с одним путём готовить файл в одном и том же временном файле.
+    std::string temporary = m_options.path + ".XXXXXX";
+    int const fd = ::mkostemp(temporary.data(), O_CLOEXEC);
+    if (fd < 0) {
+        throw exceptions::CounterExportEx(::fmt::format("Create {}: {}", temporary, std::strerror(errno)));
+    }
+    struct stat st{};
+    if (::fchmod(fd, 0644) != 0 || ::fstat(fd, &st) != 0 || ::ftruncate(fd, static_cast<off_t>(m_size)) != 0) {
+        int const error = errno;
+        ::close(fd);
+        ::unlink(temporary.c_str());
+        throw exceptions::CounterExportEx(::fmt::format("Prepare {}: {}", temporary, std::strerror(error)));
+    }
+
+    void *const memory = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int const error = errno;
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        ::unlink(temporary.c_str());
+        throw exceptions::CounterExportEx(::fmt::format("Map {}: {}", temporary, std::strerror(error)));
+    }
+
+    auto *const header = new (memory) SharedCountersHeader{};
+    header->magic = COUNTER_EXPORT_MAGIC;
+    header->version = COUNTER_EXPORT_VERSION;
+    header->capacity = static_cast<uint32_t>(m_options.capacity);
+
+    if (::rename(temporary.c_str(), m_options.path.c_str()) != 0) {
+        int const error = errno;
+        ::munmap(memory, m_size);
+        ::unlink(temporary.c_str());
+        throw exceptions::CounterExportEx(::fmt::format("Rename {}: {}", temporary, std::strerror(error)));
+    }
+    m_memory = memory;
+    m_device = st.st_dev;
+    m_inode = st.st_ino;
+}
+
+void SharedMemoryCounterExporter::unlink_file() const noexcept {
+    // Другой экземпляр с тем же путём мог заменить файл: его файл удалять нельзя.
+    struct stat st{};
+    if (::stat(m_options.path.c_str(), &st) == 0 && st.st_dev == m_device && st.st_ino == m_inode) {
+        ::unlink(m_options.path.c_str());
+    }
+}
+
+void SharedMemoryCounterExporter::start() {
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_thread = std::jthread([this](std::stop_token const &stop) { run(stop); });
+}
+
+void SharedMemoryCounterExporter::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_thread.request_stop();
+    uint64_t const one = 1;
+    ::write(m_stop_fd, &one, sizeof(one));
+    m_thread.join();
+
+    uint64_t counter = 0;
+    ::read(m_stop_fd, &counter, sizeof(counter));
+}
+
+void SharedMemoryCounterExporter::publish() {
+    std::lock_guard const lock(m_informer_mutex);
+
+    m_informer->load_caches(Cache::Link);
+    auto const interfaces = m_informer->get_all_interfaces_data(Section::General | Section::HW | Section::OperationalStatus | Section::Rx | Section::Tx);
+
+    m_slots.clear();
+    for (auto const &interface : interfaces) {
+        if (m_slots.size() == m_options.capacity) {
+            break;
+        }
+
+        SharedInterfaceCounters &slot = m_slots.emplace_back();
+        copy_string(slot.name, interface.interface);
+        copy_string(slot.oper_state, interface.operational_status.oper_state);
+        slot.ifindex = interface.general.index;
+        slot.mtu = static_cast<uint32_t>(interface.hw.mtu);
+        slot.admin_up = interface.general.state == "UP" ? 1 : 0;
+        slot.rx = interface.rx;
+        slot.tx = interface.tx;
+    }
+
+    write(static_cast<uint32_t>(interfaces.size()));
+}
+
+void SharedMemoryCounterExporter::write(uint32_t const total) {
+    auto *const header = static_cast<SharedCountersHeader *>(m_memory);
+    auto *const slots = reinterpret_cast<SharedInterfaceCounters *>(header + 1);
+
+    // Нечётное значение sequence сообщает читателям, что данные меняются; ячейки подготовлены
+    // заранее, поэтому окно записи сводится к одному копированию.
+    uint64_t const sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(static_cast<void *>(slots), m_slots.data(), m_slots.size() * sizeof(SharedInterfaceCounters));
+    header->count = static_cast<uint32_t>(m_slots.size());
+    header->total = total;
+    header->generation = ++m_generation;
+    header->timestamp_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SharedMemoryCounterExporter::run(std::stop_token const &stop) {
+    auto next = std::chrono::steady_clock::now() + m_options.interval;
+    while (!stop.stop_requested()) {
+        auto const now = std::chrono::steady_clock::now();
+        auto const timeout = next > now ? std::chrono::ceil<std::chrono::milliseconds>(next - now).count() : 0;
+
+        pollfd fd{m_stop_fd, POLLIN, 0};
+        if (::poll(&fd, 1, static_cast<int>(timeout)) < 0 && errno != EINTR) {
+            break;
+        }
+        if (stop.stop_requested()) {
+            break;
+        }
+        if (std::chrono::steady_clock::now() < next) {
+            continue;
+        }
+
+        try {
+            publish();
+        } catch (std::exception const &) {
+            // Сбой одного дампа не прерывает экспорт: в файле остаётся предыдущий снимок.
+        }
+        next += m_options.interval;
+        if (auto const current = std::chrono::steady_clock::now(); next < current) {
+            next = current + m_options.interval;
+        }
+    }
+}
+
+} // namespace os::network
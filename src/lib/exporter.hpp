@@ -0,0 +1,72 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "informer/counter_export.hpp"
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+/**
+ * @class SharedMemoryCounterExporter
+ * @brief Реализация CounterExporter: дамп кэша интерфейсов и запись в отображённый файл под seqlock
+ */
+class SharedMemoryCounterExporter final : public CounterExporter {
+   public:
+    /**
+     * @brief Конструктор, создающий файл счётчиков и публикующий первый снимок
+     * @param options Параметры издателя
+     * @throw exceptions::CounterExportEx если параметры некорректны или не удалось создать файл
+     */
+    explicit SharedMemoryCounterExporter(ExportOptions const &options);
+    ~SharedMemoryCounterExporter() override;
+
+    SharedMemoryCounterExporter(SharedMemoryCounterExporter const &) = delete;
+    SharedMemoryCounterExporter(SharedMemoryCounterExporter &&) = delete;
+    SharedMemoryCounterExporter &operator=(SharedMemoryCounterExporter const &) = delete;
+    SharedMemoryCounterExporter &operator=(SharedMemoryCounterExporter &&) = delete;
+
+    void start() override;
+    void stop() override;
+    void publish() override;
+
+   private:
+    /**
+     * @brief Создаёт файл во временном пути, отображает его и атомарно переименовывает в options.path
+     * @throw exceptions::CounterExportEx если не удалось создать или отобразить файл
+     */
+    void create_file();
+    /**
+     * @brief Удаляет options.path, если путь по-прежнему указывает на созданный этим экземпляром файл
+     */
+    void unlink_file() const noexcept;
+    /**
+     * @brief Тело фонового потока
+     * @param stop Признак остановки
+     */
+    void run(std::stop_token const &stop);
+    /**
+     * @brief Записывает ячейки в файл под seqlock
+     * @param total Количество интерфейсов в пространстве имен
+     */
+    void write(uint32_t total);
+
+    ExportOptions m_options{};                      /**< Параметры издателя */
+    std::unique_ptr<InformerNetlink> m_informer{};  /**< Кэш интерфейсов */
+    std::mutex m_informer_mutex{};                  /**< Сериализация публикаций */
+    void *m_memory{nullptr};                        /**< Отображённый файл */
+    std::size_t m_size{};                           /**< Размер отображения */
+    dev_t m_device{};                               /**< Устройство созданного файла */
+    ino_t m_inode{};                                /**< Inode созданного файла */
+    std::vector<SharedInterfaceCounters> m_slots{}; /**< Подготовленные ячейки (копируются под seqlock) */
+    uint64_t m_generation{};                        /**< Номер последнего снимка */
+    int m_stop_fd{-1};                              /**< eventfd для пробуждения потока при остановке */
+    std::jthread m_thread{};                        /**< Фоновый поток */
+};
+
+} // namespace os::network
@@ -0,0 +1,322 @@
+/**
+ * @file counter_export.hpp
+ * @brief Экспорт счётчиков интерфейсов в разделяемую память с seqlock-разметкой и библиотека чтения.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "informer/interface_info.hpp"
+
+namespace os::network {
+namespace exceptions {
+
+/**
+ * @struct CounterExportEx
+ * @brief Исключение при ошибке создания или открытия файла счётчиков.
+ */
+struct CounterExportEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @brief Сигнатура файла счётчиков ("IFCNTRS" и завершающий ноль).
+ */
+inline constexpr uint64_t COUNTER_EXPORT_MAGIC = 0x005352544E434649ull;
+/**
+ * @brief Версия разметки файла счётчиков.
+ */
+inline constexpr uint32_t COUNTER_EXPORT_VERSION = 1;
+
+/**
+ * @struct SharedCountersHeader
+ * @brief Заголовок файла счётчиков.
+ *
+ * Поля после sequence изменяются только под seqlock: нечётное значение sequence означает,
+ * что издатель пишет снимок.
+ */
+struct SharedCountersHeader {
+    uint64_t magic{};                 /**< COUNTER_EXPORT_MAGIC */
+    uint32_t version{};               /**< COUNTER_EXPORT_VERSION */
+    uint32_t capacity{};              /**< Количество ячеек интерфейсов */
+    std::atomic<uint64_t> sequence{}; /**< Счётчик seqlock (0 - снимок ещё не опубликован) */
+    uint64_t generation{};            /**< Номер снимка */
+    uint64_t timestamp_ns{};          /**< Время снимка (system_clock, наносекунды от эпохи) */
+    uint32_t count{};                 /**< Заполненные ячейки */
+    uint32_t total{};                 /**< Интерфейсы в пространстве имен (может превышать capacity) */
+    uint64_t reserved[2]{};           /**< Резерв до 64 байт */
+};
+
+/**
+ * @struct SharedInterfaceCounters
+ * @brief Ячейка интерфейса в файле счётчиков.
+ */
+struct SharedInterfaceCounters {
+    char name[16]{};       /**< Имя интерфейса (завершается нулём) */
+    char oper_state[16]{}; /**< Операционное состояние (UP, DOWN, UNKNOWN и т.д.) */
+    int32_t ifindex{};     /**< Индекс интерфейса */
+    uint32_t mtu{};        /**< MTU */
+    uint32_t admin_up{};   /**< 1, если интерфейс включён (IFF_UP) */
+    uint32_t reserved{};   /**< Выравнивание */
+    Packetometr rx{};      /**< Статистика приёма */
+    Packetometr tx{};      /**< Статистика отправки */
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock requires lock-free 64-bit atomics");
+static_assert(sizeof(SharedCountersHeader) == 64 && std::is_standard_layout_v<SharedCountersHeader>);
+static_assert(sizeof(SharedInterfaceCounters) == 112 && std::is_trivially_copyable_v<SharedInterfaceCounters>);
+
+/**
+ * @struct CounterSnapshot
+ * @brief Согласованная копия файла счётчиков.
+ */
+struct CounterSnapshot {
+    uint64_t generation{};                             /**< Номер снимка */
+    uint64_t timestamp_ns{};                           /**< Время снимка */
+    uint32_t total{};                                  /**< Интерфейсы в пространстве имен */
+    std::vector<SharedInterfaceCounters> interfaces{}; /**< Заполненные ячейки */
+};
+
+/**
+ * @struct ExportOptions
+ * @brief Параметры создания CounterExporter.
+ */
+struct ExportOptions {
+    std::string path{"/dev/shm/interface_informer.counters"}; /**< Файл счётчиков */
+    std::chrono::milliseconds interval{1000};                 /**< Период обновления */
+    std::size_t capacity{1024};                               /**< Количество ячеек интерфейсов */
+    int namespace_fd{-1};                                     /**< Пространство имен (-1 - текущее пространство имен) */
+};
+
+/**
+ * @class CounterExporter
+ * @brief Абстрактный класс издателя счётчиков в разделяемую память.
+ *
+ * Издатель один раз за период выполняет дамп интерфейсов и записывает счётчики и состояние в
+ * отображаемый в память файл, поэтому ядро опрашивается один раз на узел, а не каждым агентом.
+ * Читатели (CounterReader) получают согласованные снимки без системных вызовов. Файл создаётся
+ * заново при создании издателя и удаляется при его разрушении; читатель, открытый до перезапуска
+ * издателя, продолжает видеть последний снимок старого файла (см. CounterReader::is_current).
+ */
+class CounterExporter {
+   public:
+    CounterExporter() = default;
+    virtual ~CounterExporter() = default;
+
+    CounterExporter(CounterExporter const &) = delete;
+    CounterExporter(CounterExporter &&) = delete;
+    CounterExporter &operator=(CounterExporter const &) = delete;
+    CounterExporter &operator=(CounterExporter &&) = delete;
+
+    /**
+     * @brief Запускает фоновый поток обновления.
+     */
+    virtual void start() = 0;
+    /**
+     * @brief Останавливает фоновый поток. Последний снимок остаётся в файле.
+     */
+    virtual void stop() = 0;
+    /**
+     * @brief Выполняет дамп и публикует снимок в вызывающем потоке.
+     * @throw std::runtime_error если не удалось получить данные.
+     */
+    virtual void publish() = 0;
+    /**
+     * @brief Создает экземпляр класса-наследника CounterExporter и публикует первый снимок.
+     * @param options Параметры издателя.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<CounterExporter> create(ExportOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника CounterExporter.
+     * @param options Параметры издателя.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static CounterExporter *create(ExportOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника CounterExporter и публикует первый снимок.
+ * @param options Параметры издателя.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<CounterExporter> CounterExporter::create(ExportOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    CounterExporter *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<CounterExporter>{new_object};
+}
+
+/**
+ * @class CounterReader
+ * @brief Чтение файла счётчиков, опубликованного CounterExporter.
+ *
+ * Не зависит от libnl и не выполняет системных вызовов после открытия: снимок копируется из
+ * отображённой памяти и повторяется, если во время копирования издатель начал запись.
+ */
+class CounterReader final {
+   public:
+    /**
+     * @brief Открывает и отображает файл счётчиков только для чтения.
+     * @param path Путь к файлу.
+     * @throw exceptions::CounterExportEx если файл не открывается или имеет неверный формат.
+     */
+    explicit CounterReader(std::string path = ExportOptions{}.path) : m_path{std::move(path)} {
+        int const fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw exceptions::CounterExportEx("Open " + m_path + ": " + std::strerror(errno));
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SharedCountersHeader)) {
+            ::close(fd);
+            throw exceptions::CounterExportEx("Counter file " + m_path + " is too small");
+        }
+        m_device = st.st_dev;
+        m_inode = st.st_ino;
+        m_size = static_cast<std::size_t>(st.st_size);
+
+        void *const memory = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            throw exceptions::CounterExportEx("Map " + m_path + ": " + std::strerror(errno));
+        }
+        m_header = static_cast<SharedCountersHeader const *>(memory);
+        m_slots = reinterpret_cast<SharedInterfaceCounters const *>(m_header + 1);
+
+        if (m_header->magic != COUNTER_EXPORT_MAGIC || m_header->version != COUNTER_EXPORT_VERSION ||
+            m_size < sizeof(SharedCountersHeader) + std::size_t{m_header->capacity} * sizeof(SharedInterfaceCounters)) {
+            ::munmap(memory, m_size);
+            throw exceptions::CounterExportEx("Counter file " + m_path + " has unsupported format");
+        }
+    }
+    ~CounterReader() { ::munmap(const_cast<SharedCountersHeader *>(m_header), m_size); }
+
+    CounterReader(CounterReader const &) = delete;
+    CounterReader(CounterReader &&) = delete;
+    CounterReader &operator=(CounterReader const &) = delete;
+    CounterReader &operator=(CounterReader &&) = delete;
+
+    /**
+     * @brief Копирует согласованный снимок.
+     *
+     * Память snapshot.interfaces переиспользуется, поэтому повторные чтения в тот же объект не выделяют память.
+     * @param snapshot Приёмник снимка.
+     * @return false, если снимок ещё не опубликован или издатель не завершил запись за отведённые попытки.
+     */
+    bool read(CounterSnapshot &snapshot) const noexcept {
+        for (int attempt = 0; attempt < M_MAX_ATTEMPTS; ++attempt) {
+            uint64_t const begin = m_header->sequence.load(std::memory_order_acquire);
+            if (begin == 0) {
+                return false;
+            }
+            if (begin & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint32_t const count = std::min(m_header->count, m_header->capacity);
+            snapshot.generation = m_header->generation;
+            snapshot.timestamp_ns = m_header->timestamp_ns;
+            snapshot.total = m_header->total;
+            snapshot.interfaces.resize(count);
+            std::memcpy(static_cast<void *>(snapshot.interfaces.data()), m_slots, count * sizeof(SharedInterfaceCounters));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_header->sequence.load(std::memory_order_relaxed) == begin) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * @brief Копирует согласованное состояние одного интерфейса.
+     * @param name Имя интерфейса.
+     * @return Ячейка интерфейса или std::nullopt, если интерфейс не найден или снимок недоступен.
+     */
+    [[nodiscard]] std::optional<SharedInterfaceCounters> find(std::string_view name) const noexcept {
+        for (int attempt = 0; attempt < M_MAX_ATTEMPTS; ++attempt) {
+            uint64_t const begin = m_header->sequence.load(std::memory_order_acquire);
+            if (begin == 0) {
+                return std::nullopt;
+            }
+            if (begin & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::optional<SharedInterfaceCounters> found;
+            uint32_t const count = std::min(m_header->count, m_header->capacity);
+            for (uint32_t i = 0; i < count && !found; ++i) {
+                if (std::string_view{m_slots[i].name, ::strnlen(m_slots[i].name, sizeof(m_slots[i].name))} == name) {
+                    found.emplace();
+                    std::memcpy(static_cast<void *>(&*found), &m_slots[i], sizeof(SharedInterfaceCounters));
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_header->sequence.load(std::memory_order_relaxed) == begin) {
+                return found;
+            }
+        }
+        return std::nullopt;
+    }
+    /**
+     * @brief Проверяет, что путь по-прежнему указывает на отображённый файл (издатель не перезапускался).
+     *
+     * В отличие от остальных методов выполняет системный вызов stat.
+     * @return false, если файл удалён или заменён.
+     */
+    [[nodiscard]] bool is_current() const noexcept {
+        struct stat st{};
+        return ::stat(m_path.c_str(), &st) == 0 && st.st_dev == m_device && st.st_ino == m_inode;
+    }
+
+   private:
+    /**
+     * @brief Количество попыток чтения, после которого считается, что издатель завис посреди записи.
+     */
+    static constexpr int M_MAX_ATTEMPTS = 1000;
+
+    std::string m_path{};                            /**< Путь к файлу */
+    SharedCountersHeader const *m_header{nullptr};   /**< Заголовок в отображённой памяти */
+    SharedInterfaceCounters const *m_slots{nullptr}; /**< Ячейки в отображённой памяти */
+    std::size_t m_size{};                            /**< Размер отображения */
+    dev_t m_device{};                                /**< Устройство отображённого файла */
+    ino_t m_inode{};                                 /**< Inode отображённого файла */
+};
+} // namespace os::network
@@ -0,0 +1,132 @@
+/**
+ * @file counter_sampler.hpp
+ * @brief Периодический сбор счётчиков сетевых интерфейсов в кольцевые буферы со статистикой скоростей.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace os::network {
+
+/**
+ * @struct RateStats
+ * @brief Статистика скорости изменения счётчика за окно (единиц в секунду).
+ */
+struct RateStats {
+    double min{}; /**< Минимальная скорость между соседними отсчётами */
+    double max{}; /**< Максимальная скорость между соседними отсчётами */
+    double avg{}; /**< Средняя скорость за окно */
+    double p95{}; /**< 95-й перцентиль скорости между соседними отсчётами */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(RateStats, min, max, avg, p95);
+
+/**
+ * @struct InterfaceRates
+ * @brief Статистика скоростей приёма и передачи интерфейса за окно.
+ */
+struct InterfaceRates {
+    std::string interface{}; /**< Имя интерфейса */
+    RateStats rx_bytes{};    /**< Скорость приёма, байт/с */
+    RateStats rx_packets{};  /**< Скорость приёма, пакетов/с */
+    RateStats tx_bytes{};    /**< Скорость передачи, байт/с */
+    RateStats tx_packets{};  /**< Скорость передачи, пакетов/с */
+    std::size_t samples{};   /**< Количество отсчётов, попавших в окно */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(InterfaceRates, interface, rx_bytes, rx_packets, tx_bytes, tx_packets, samples);
+
+/**
+ * @struct SamplerOptions
+ * @brief Параметры создания CounterSampler.
+ */
+struct SamplerOptions {
+    std::chrono::milliseconds interval{1000}; /**< Период опроса счётчиков */
+    std::size_t capacity{600};                /**< Количество отсчётов в кольцевом буфере каждого интерфейса */
+};
+
+/**
+ * @class CounterSampler
+ * @brief Абстрактный класс периодического сборщика счётчиков интерфейсов.
+ *
+ * Сборщик использует собственный сокет Netlink (в пространстве имен, в котором он создан) и
+ * собственный поток опроса. Для каждого интерфейса заранее выделяется кольцевой буфер на
+ * SamplerOptions::capacity отсчётов; при опросе память выделяется только для интерфейсов,
+ * появившихся впервые, поэтому опрос с частотой 10-100 Гц не создаёт нагрузки на аллокатор.
+ */
+class CounterSampler {
+   public:
+    CounterSampler() = default;
+    virtual ~CounterSampler() = default;
+
+    CounterSampler(CounterSampler const &) = delete;
+    CounterSampler(CounterSampler &&) = delete;
+    CounterSampler &operator=(CounterSampler const &) = delete;
+    CounterSampler &operator=(CounterSampler &&) = delete;
+
+    /**
+     * @brief Запускает фоновый опрос счётчиков с периодом SamplerOptions::interval.
+     */
+    virtual void start() = 0;
+    /**
+     * @brief Останавливает фоновый опрос. Накопленные отсчёты сохраняются.
+     */
+    virtual void stop() = 0;
+    /**
+     * @brief Выполняет один отсчёт в вызывающем потоке (например, при ручном управлении опросом).
+     * @throw std::runtime_error если не удалось получить счётчики.
+     */
+    virtual void sample() = 0;
+    /**
+     * @brief Вычисляет статистику скоростей интерфейса за последнее окно.
+     * @param interface_name Имя интерфейса.
+     * @param window Длительность окна, отсчитываемого от последнего отсчёта.
+     * @return Статистика или std::nullopt, если интерфейс неизвестен или в окне меньше двух отсчётов.
+     */
+    [[nodiscard]] virtual std::optional<InterfaceRates> get_rates(std::string const &interface_name,
+                                                                  std::chrono::milliseconds window) const = 0;
+    /**
+     * @brief Создает экземпляр класса-наследника CounterSampler.
+     * @param options Параметры опроса.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<CounterSampler> create(SamplerOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника CounterSampler.
+     * @param options Параметры опроса.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static CounterSampler *create(SamplerOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника CounterSampler.
+ * @param options Параметры опроса.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<CounterSampler> CounterSampler::create(SamplerOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    CounterSampler *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<CounterSampler>{new_object};
+}
+} // namespace os::network
@@ -0,0 +1,129 @@
+/**
+ * @file interface_admin.hpp
+ * @brief Асинхронное управление состоянием сетевых интерфейсов с конвейерной отправкой запросов Netlink.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+/**
+ * @brief Обработчик завершения асинхронной операции.
+ *
+ * Вызывается в служебном потоке InterfaceAdmin и не должен выполнять долгих действий. Исключение,
+ * выброшенное обработчиком, перехватывается и отбрасывается: оно не доходит до вызывающего кода
+ * и не влияет на служебный поток и другие операции.
+ */
+using InterfaceChangeCallback = std::function<void(InterfaceChangeResult const &)>;
+
+/**
+ * @struct AdminOptions
+ * @brief Параметры создания InterfaceAdmin.
+ */
+struct AdminOptions {
+    std::size_t max_in_flight{32}; /**< Максимальное количество запросов, ожидающих подтверждения ядра */
+    int namespace_fd{-1};          /**< Пространство имен (-1 - текущее пространство имен) */
+};
+
+/**
+ * @class InterfaceAdmin
+ * @brief Абстрактный класс асинхронного управления интерфейсами.
+ *
+ * Запросы из любых потоков ставятся в очередь и немедленно возвращают управление. Служебный поток
+ * отправляет накопившиеся запросы одним системным вызовом через собственный неблокирующий сокет,
+ * не дожидаясь подтверждения предыдущих, и завершает каждую операцию по её подтверждению или ошибке
+ * ядра, сопоставляя их по порядковому номеру сообщения. Интерфейс ищется ядром по имени, поэтому
+ * кэши не используются; экземпляры InformerNetlink узнают об изменениях из уведомлений или refresh().
+ *
+ * Операции, не завершённые к моменту разрушения объекта, завершаются с кодом ECANCELED.
+ */
+class InterfaceAdmin {
+   public:
+    InterfaceAdmin() = default;
+    virtual ~InterfaceAdmin() = default;
+
+    InterfaceAdmin(InterfaceAdmin const &) = delete;
+    InterfaceAdmin(InterfaceAdmin &&) = delete;
+    InterfaceAdmin &operator=(InterfaceAdmin const &) = delete;
+    InterfaceAdmin &operator=(InterfaceAdmin &&) = delete;
+
+    /**
+     * @brief Асинхронно изменяет административное состояние интерфейса.
+     * @param change Интерфейс и требуемое состояние.
+     * @return Результат, доступный после подтверждения ядра.
+     * @throw std::runtime_error Если не удалось разбудить служебный поток.
+     */
+    virtual std::future<InterfaceChangeResult> set_interface_state(InterfaceStateChange const &change) = 0;
+    /**
+     * @brief Асинхронно изменяет административное состояние интерфейса с обработчиком завершения.
+     * @param change Интерфейс и требуемое состояние.
+     * @param callback Обработчик, вызываемый ровно один раз.
+     * @throw std::runtime_error Если не удалось разбудить служебный поток; операция при этом не выполняется
+     *        и обработчик не вызывается.
+     */
+    virtual void set_interface_state(InterfaceStateChange const &change, InterfaceChangeCallback callback) = 0;
+    /**
+     * @brief Асинхронно включает интерфейс.
+     * @param interface_name Имя интерфейса.
+     * @return Результат, доступный после подтверждения ядра.
+     */
+    std::future<InterfaceChangeResult> enable_interface(std::string const &interface_name) {
+        return set_interface_state({interface_name, true});
+    }
+    /**
+     * @brief Асинхронно выключает интерфейс.
+     * @param interface_name Имя интерфейса.
+     * @return Результат, доступный после подтверждения ядра.
+     */
+    std::future<InterfaceChangeResult> disable_interface(std::string const &interface_name) {
+        return set_interface_state({interface_name, false});
+    }
+    /**
+     * @brief Создает экземпляр класса-наследника InterfaceAdmin и запускает служебный поток.
+     * @param options Параметры.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<InterfaceAdmin> create(AdminOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника InterfaceAdmin.
+     * @param options Параметры.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static InterfaceAdmin *create(AdminOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника InterfaceAdmin и запускает служебный поток.
+ * @param options Параметры.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<InterfaceAdmin> InterfaceAdmin::create(AdminOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    InterfaceAdmin *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<InterfaceAdmin>{new_object};
+}
+} // namespace os::network
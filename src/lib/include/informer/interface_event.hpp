@@ -0,0 +1,78 @@
+/**
+ * @file interface_event.hpp
+ * @brief Типизированные события об изменениях интерфейсов, адресов, маршрутов и соседей.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace os::network {
+
+/**
+ * @enum Event
+ * @brief Вид события; битовая маска для подписки.
+ */
+enum class Event : unsigned {
+    None = 0,                     /**< Ни одного события */
+    LinkAdded = 1u << 0,          /**< Появился интерфейс */
+    LinkRemoved = 1u << 1,        /**< Интерфейс удалён */
+    LinkUp = 1u << 2,             /**< Интерфейс включён (установлен IFF_UP) */
+    LinkDown = 1u << 3,           /**< Интерфейс выключен (снят IFF_UP) */
+    CarrierUp = 1u << 4,          /**< Появилась несущая (установлен IFF_LOWER_UP) */
+    CarrierDown = 1u << 5,        /**< Пропала несущая (снят IFF_LOWER_UP) */
+    MtuChanged = 1u << 6,         /**< Изменился MTU */
+    AddrAdded = 1u << 7,          /**< Добавлен IP-адрес */
+    AddrRemoved = 1u << 8,        /**< Удалён IP-адрес */
+    RouteAdded = 1u << 9,         /**< Добавлен маршрут */
+    RouteRemoved = 1u << 10,      /**< Удалён маршрут */
+    NeighAdded = 1u << 11,        /**< Добавлена запись ARP/NDP */
+    NeighRemoved = 1u << 12,      /**< Удалена запись ARP/NDP */
+    NeighStateChanged = 1u << 13, /**< Изменилось состояние записи ARP/NDP */
+    Link = LinkAdded | LinkRemoved | LinkUp | LinkDown | CarrierUp | CarrierDown | MtuChanged,
+    Addr = AddrAdded | AddrRemoved,
+    Route = RouteAdded | RouteRemoved,
+    Neigh = NeighAdded | NeighRemoved | NeighStateChanged,
+    All = Link | Addr | Route | Neigh
+};
+
+constexpr Event operator|(Event const lhs, Event const rhs) {
+    return static_cast<Event>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+}
+constexpr Event operator&(Event const lhs, Event const rhs) {
+    return static_cast<Event>(static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs));
+}
+
+/**
+ * @struct InterfaceEvent
+ * @brief Изменение, построенное по уведомлению ядра.
+ *
+ * Заполняются только поля, относящиеся к виду события; остальные остаются значениями по умолчанию.
+ */
+struct InterfaceEvent {
+    Event type{Event::None};                          /**< Вид события (один бит маски) */
+    int ifindex{};                                    /**< Индекс интерфейса (для маршрута - первого nexthop) */
+    std::string interface{};                          /**< Имя интерфейса (пусто, если интерфейс уже неизвестен) */
+    unsigned flags{};                                 /**< Флаги IFF_* интерфейса после изменения */
+    unsigned previous_flags{};                        /**< Флаги IFF_* интерфейса до изменения */
+    uint32_t mtu{};                                   /**< MTU после изменения */
+    uint32_t previous_mtu{};                          /**< MTU до изменения */
+    int family{};                                     /**< Семейство адреса (AF_INET, AF_INET6) */
+    std::string address{};                            /**< Адрес с префиксом, назначение маршрута или IP-адрес соседа */
+    std::string mac{};                                /**< MAC-адрес соседа */
+    uint32_t table{};                                 /**< Таблица маршрутизации */
+    unsigned state{};                                 /**< Состояние соседа (маска NUD_*) после изменения */
+    unsigned previous_state{};                        /**< Состояние соседа (маска NUD_*) до изменения */
+    std::chrono::steady_clock::time_point received{}; /**< Момент разбора уведомления */
+};
+
+/**
+ * @brief Обработчик событий подписки. Исключения обработчика перехватываются и отбрасываются.
+ */
+using InterfaceEventCallback = std::function<void(InterfaceEvent const &)>;
+
+} // namespace os::network
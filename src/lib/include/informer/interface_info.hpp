@@ -0,0 +1,130 @@
+/**
+ * @file interface_info.hpp
+ * @brief Типизированное представление подробной информации о сетевом интерфейсе.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace os::network {
+
+/**
+ * @struct Packetometr
+ * @brief Статистика сетевого трафика интерфейса
+ */
+struct Packetometr {
+    uint64_t bytes{};   /**< Количество байт (8 байт) */
+    uint64_t packets{}; /**< Количество пакетов (8 байт) */
+    uint64_t errors{};  /**< Количество ошибок (8 байт) */
+    uint64_t drops{};   /**< Количество отброшенных пакетов (8 байт) */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Packetometr, bytes, packets, errors, drops);
+
+/**
+ * @struct Neigh
+ * @brief Структура для хранения информации о соседях (ARP/NDP таблица)
+ */
+struct Neigh {
+    std::string ip{};                /**< IP-адрес соседа */
+    std::string mac{};               /**< MAC-адрес соседа */
+    std::vector<std::string> type{}; /**< Типы соседей (PERMANENT, REACHABLE и т.д.) */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Neigh, ip, mac, type);
+
+/**
+ * @struct Routes
+ * @brief Структура для хранения информации о маршрутах
+ */
+struct Routes {
+    std::string destination{}; /**< Адрес назначения маршрута */
+    std::string gateway{};     /**< Шлюз для маршрута */
+    std::string type{};        /**< Тип маршрута (UNICAST, LOCAL, BROADCAST и т.д.) */
+    uint32_t metric{};         /**< Метрика маршрута */
+    uint32_t table{};          /**< Таблица маршрутизации */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Routes, destination, gateway, metric, table, type);
+
+/**
+ * @struct Ip
+ * @brief Структура для хранения информации об IP-адресах интерфейса
+ */
+struct Ip {
+    std::string type{};               /**< Тип IP-адреса (IPv4 или IPv6) */
+    std::string ip{};                 /**< IP-адрес с маской подсети */
+    std::string broadcast{};          /**< Широковещательный адрес (для IPv4) */
+    std::string peer{};               /**< Адрес пира (для point-to-point интерфейсов) */
+    std::vector<std::string> flags{}; /**< Флаги IP-адреса (PERMANENT, SECONDARY и т.д.) */
+    int masc{};                       /**< Маска подсети в формате CIDR */
+    uint32_t valid_lft{};             /**< Срок действия адреса (valid lifetime) */
+    uint32_t pref_lft{};              /**< Предпочтительный срок действия (preferred lifetime) */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Ip, type, ip, masc, flags, valid_lft, pref_lft, broadcast, peer);
+
+/**
+ * @struct Protocols
+ * @brief Структура для хранения информации о поддерживаемых протоколах
+ */
+struct Protocols {
+    bool routing_ipv4{}; /**< Поддерживается ли IPv4 маршрутизация */
+    bool multicast{};    /**< Поддерживается ли многоадресная рассылка */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Protocols, routing_ipv4, multicast);
+
+/**
+ * @struct OperationalStatus
+ * @brief Структура для хранения информации об операционном статусе интерфейса
+ */
+struct OperationalStatus {
+    std::string oper_state{}; /**< Операционное состояние интерфейса */
+    std::string link_mode{};  /**< Режим соединения */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(OperationalStatus, oper_state, link_mode);
+
+/**
+ * @struct HW
+ * @brief Структура для хранения аппаратной информации об интерфейсе
+ */
+struct HW {
+    std::string type{};             /**< Тип аппаратного интерфейса (Ethernet, Loopback и т.д.) */
+    std::vector<std::string> mac{}; /**< MAC-адрес(а) интерфейса */
+    uint64_t mtu{};                 /**< Максимальный размер передаваемого блока (MTU) */
+    uint64_t size_queue{};          /**< Размер очереди передачи (txqlen) */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(HW, type, mac, mtu, size_queue);
+
+/**
+ * @struct General
+ * @brief Структура для хранения общей информации об интерфейсе
+ */
+struct General {
+    std::string state{};              /**< Состояние интерфейса (UP/DOWN) */
+    std::string type{};               /**< Тип интерфейса (BROADCAST, LOOPBACK и т.д.) */
+    std::vector<std::string> flags{}; /**< Флаги интерфейса */
+    int index{};                      /**< Индекс интерфейса */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(General, index, state, type, flags);
+
+/**
+ * @struct Json
+ * @brief Структура для формирования полного JSON-ответа с информацией об интерфейсе
+ */
+struct Json {
+    General general{};                      /**< Общая информация об интерфейсе (96 байт)*/
+    HW hw{};                                /**< Аппаратная информация (72 байт) */
+    OperationalStatus operational_status{}; /**< Операционный статус (64 байт) */
+    std::string interface{};                /**< Имя интерфейса (32 байт) */
+    Packetometr tx{};                       /**< Статистика отправки (32 байт) */
+    Packetometr rx{};                       /**< Статистика приёма (32 байт) */
+    std::vector<Ip> ip{};                   /**< Список IP-адресов (24 байт) */
+    std::vector<Routes> routes{};           /**< Список маршрутов (24 байт) */
+    std::vector<Neigh> neigh{};             /**< Список соседей (ARP/NDP) (24 байт) */
+    Protocols protocols{};                  /**< Поддерживаемые протоколы (2 байт) */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Json, interface, general, hw, operational_status, protocols, ip, routes, neigh, tx, rx);
+
+} // namespace os::network
@@ -9,8 +9,14 @@
 #include <dirent.h>
 #include <fcntl.h>
 #include <fmt/format.h>
+#include <sys/socket.h>
 
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <vector>
+
+#include "informer/interface_event.hpp"
+#include "informer/interface_info.hpp"
 
 namespace os::network {
 namespace exceptions {
@@ -38,8 +44,281 @@ struct OpenNamespace final : NetNamespaceHandlerEx {
 struct SwitchNamespace final : NetNamespaceHandlerEx {
     using NetNamespaceHandlerEx::NetNamespaceHandlerEx;
 };
+
+/**
+ * @struct NetlinkEx
+ * @brief Базовое исключение для ошибок Netlink
+ */
+struct NetlinkEx : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @struct AllocateSocket
+ * @brief Исключение при невозможности выделить сокет Netlink
+ */
+struct AllocateSocket final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct ConnectNetlinkRoute
+ * @brief Исключение при ошибке подключения к NETLINK_ROUTE
+ */
+struct ConnectNetlinkRoute final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct GetDataLinks
+ * @brief Исключение при ошибке получения данных о сетевых интерфейсах
+ */
+struct GetDataLinks final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct GetDataAddr
+ * @brief Исключение при ошибке получения данных об IP-адресах
+ */
+struct GetDataAddr final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct GetDataRoute
+ * @brief Исключение при ошибке получения данных о маршрутах
+ */
+struct GetDataRoute final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct GetDataNeigh
+ * @brief Исключение при ошибке получения данных о соседях
+ */
+struct GetDataNeigh final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct CacheManager
+ * @brief Исключение при ошибке создания менеджера кэшей или подписки на уведомления Netlink
+ */
+struct CacheManager final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct InterfaceNotFound
+ * @brief Исключение, когда запрошенный интерфейс не найден
+ */
+struct InterfaceNotFound final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct InterfaceOperationEx
+ * @brief Исключение при ошибке операции с интерфейсом (включение/выключение)
+ */
+struct InterfaceOperationEx final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct InvalidAddress
+ * @brief Исключение, когда строка не является адресом IPv4 или IPv6
+ */
+struct InvalidAddress final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
+
+/**
+ * @struct OutOfScope
+ * @brief Исключение, когда запрос выходит за ограничение дампа (DumpScope)
+ */
+struct OutOfScope final : NetlinkEx {
+    using NetlinkEx::NetlinkEx;
+};
 } // namespace exceptions
 
+/**
+ * @enum UpdateMode
+ * @brief Способ поддержания кэшей Netlink в актуальном состоянии.
+ *
+ * Ядро не отправляет RTM_NEWLINK при изменении счётчиков, поэтому в режиме Events секции rx/tx
+ * обновляются только вместе с другими изменениями интерфейса или после load_caches(Cache::Link).
+ */
+enum class UpdateMode {
+    Snapshot, /**< Кэши загружаются целиком при создании и перезагружаются полным дампом */
+    Events    /**< Кэши подписаны на multicast-группы Netlink и обновляются по уведомлениям ядра */
+};
+
+/**
+ * @enum Cache
+ * @brief Битовая маска кэшей Netlink.
+ */
+enum class Cache : unsigned {
+    None = 0,        /**< Ни одного кэша */
+    Link = 1u << 0,  /**< Сетевые интерфейсы */
+    Addr = 1u << 1,  /**< IP-адреса */
+    Route = 1u << 2, /**< Маршруты */
+    Neigh = 1u << 3, /**< Соседи (ARP/NDP) */
+    All = Link | Addr | Route | Neigh
+};
+
+constexpr Cache operator|(Cache const lhs, Cache const rhs) {
+    return static_cast<Cache>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+}
+constexpr Cache operator&(Cache const lhs, Cache const rhs) {
+    return static_cast<Cache>(static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs));
+}
+
+/**
+ * @enum Section
+ * @brief Битовая маска секций подробной информации об интерфейсе.
+ *
+ * Поле "interface" (имя интерфейса) присутствует в ответе всегда.
+ */
+enum class Section : unsigned {
+    None = 0,                    /**< Только имя интерфейса */
+    General = 1u << 0,           /**< Секция "general" */
+    HW = 1u << 1,                /**< Секция "hw" */
+    OperationalStatus = 1u << 2, /**< Секция "operational_status" */
+    Protocols = 1u << 3,         /**< Секция "protocols" */
+    Ip = 1u << 4,                /**< Секция "ip" (использует кэш адресов) */
+    Routes = 1u << 5,            /**< Секция "routes" (использует кэш маршрутов) */
+    Neigh = 1u << 6,             /**< Секция "neigh" (использует кэш соседей) */
+    Tx = 1u << 7,                /**< Секция "tx" */
+    Rx = 1u << 8,                /**< Секция "rx" */
+    All = General | HW | OperationalStatus | Protocols | Ip | Routes | Neigh | Tx | Rx
+};
+
+constexpr Section operator|(Section const lhs, Section const rhs) {
+    return static_cast<Section>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+}
+constexpr Section operator&(Section const lhs, Section const rhs) {
+    return static_cast<Section>(static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs));
+}
+
+/**
+ * @brief Проверяет, входит ли секция в маску.
+ * @param sections Маска секций.
+ * @param section Проверяемая секция.
+ * @return true, если секция запрошена.
+ */
+constexpr bool has_section(Section const sections, Section const section) { return (sections & section) != Section::None; }
+
+/**
+ * @brief Определяет кэши, необходимые для заполнения секций.
+ * @param sections Маска секций.
+ * @return Маска кэшей (кэш интерфейсов нужен всегда).
+ */
+constexpr Cache required_caches(Section const sections) {
+    Cache caches = Cache::Link;
+    if (has_section(sections, Section::Ip)) {
+        caches = caches | Cache::Addr;
+    }
+    if (has_section(sections, Section::Routes)) {
+        caches = caches | Cache::Route;
+    }
+    if (has_section(sections, Section::Neigh)) {
+        caches = caches | Cache::Neigh;
+    }
+    return caches;
+}
+
+/**
+ * @struct DumpScope
+ * @brief Ограничение дампов маршрутов и IP-адресов.
+ *
+ * Условия передаются ядру в запросе дампа со строгой проверкой (NETLINK_GET_STRICT_CHK, Linux 4.20+),
+ * и ядро не передаёт объекты других таблиц, семейств и интерфейсов. Если ядро не поддерживает строгую
+ * проверку или данные воспроизводятся из дампа, лишние объекты удаляются из кэша после разбора.
+ *
+ * Ограничение действует на все запросы к кэшам маршрутов и адресов: разделы вывода содержат только
+ * попавшие в него объекты, а InformerNetlink::lookup_route отклоняет поиск, ответ на который зависит
+ * от отброшенных маршрутов. Кэши интерфейсов и соседей не ограничиваются.
+ */
+struct DumpScope {
+    int family{AF_UNSPEC};   /**< Семейство маршрутов и адресов (AF_UNSPEC - все) */
+    uint32_t table{};        /**< Таблица маршрутизации (0 - все таблицы) */
+    std::string interface{}; /**< Исходящий интерфейс маршрутов и интерфейс адресов (пусто - все) */
+
+    /**
+     * @brief Проверяет, ограничивает ли дамп хотя бы одно условие.
+     * @return true, если ограничений нет.
+     */
+    [[nodiscard]] bool empty() const noexcept { return family == AF_UNSPEC && table == 0 && interface.empty(); }
+};
+
+/**
+ * @struct InformerOptions
+ * @brief Параметры создания экземпляра InformerNetlink.
+ */
+struct InformerOptions {
+    UpdateMode update_mode{UpdateMode::Snapshot}; /**< Способ обновления кэшей */
+    Cache preload{Cache::All}; /**< Кэши, загружаемые при создании; остальные загружаются при первом обращении */
+    DumpScope scope{};         /**< Ограничение кэшей маршрутов и адресов (только UpdateMode::Snapshot) */
+};
+
+/**
+ * @struct InterfaceStateChange
+ * @brief Требуемое административное состояние интерфейса в пакетной операции.
+ */
+struct InterfaceStateChange {
+    std::string interface_name{}; /**< Имя интерфейса */
+    bool up{true};                /**< true - включить, false - выключить */
+};
+
+/**
+ * @struct InterfaceChangeResult
+ * @brief Результат одного изменения пакетной операции.
+ */
+struct InterfaceChangeResult {
+    std::string interface_name{}; /**< Имя интерфейса */
+    int error{0};                 /**< 0 - изменение применено, иначе код errno */
+    std::string message{};        /**< Описание ошибки (пусто при успехе) */
+
+    /**
+     * @brief Проверяет, применено ли изменение.
+     * @return true, если ядро подтвердило изменение.
+     */
+    [[nodiscard]] bool ok() const noexcept { return error == 0; }
+};
+
+/**
+ * @struct RouteMatch
+ * @brief Маршрут, выбранный для адреса назначения.
+ */
+struct RouteMatch {
+    Routes route{};          /**< Маршрут в том же виде, что и в секции routes */
+    std::string interface{}; /**< Исходящий интерфейс (пусто для маршрутов без nexthop, например BLACKHOLE) */
+    int ifindex{};           /**< Индекс исходящего интерфейса (0, если интерфейса нет) */
+    int prefix_length{};     /**< Длина совпавшего префикса */
+};
+
+/**
+ * @struct NeighbourFilter
+ * @brief Условия выборки записей ARP/NDP.
+ */
+struct NeighbourFilter {
+    std::string interface{}; /**< Интерфейс (пусто - все интерфейсы) */
+    int family{AF_UNSPEC};   /**< AF_INET, AF_INET6 или AF_UNSPEC - оба семейства */
+    uint16_t states{};       /**< Маска состояний NUD_* (0 - любые), например NUD_FAILED | NUD_INCOMPLETE */
+};
+
+/**
+ * @struct NeighbourEntry
+ * @brief Запись ARP/NDP вместе с интерфейсом.
+ */
+struct NeighbourEntry {
+    std::string interface{}; /**< Имя интерфейса */
+    int ifindex{};           /**< Индекс интерфейса */
+    uint16_t state{};        /**< Состояние NUD_* (то же, что в neigh.type) */
+    Neigh neigh{};           /**< Запись в том же виде, что и в секции neigh */
+};
+
 /**
  * @class InformerNetlink
  * @brief Абстрактный класс для получения информации о сетевых интерфейсах через Netlink.
@@ -71,17 +350,162 @@ class InformerNetlink {
      * @throw exceptions::InterfaceOperationEx если операция не удалась.
      */
     virtual void disable_interface(std::string const &interface_name) = 0;
+    /**
+     * @brief Изменяет административное состояние нескольких интерфейсов.
+     *
+     * Запросы отправляются пачками, по одному системному вызову на пачку, без ожидания
+     * подтверждения каждого запроса; подтверждения и ошибки ядра сопоставляются с запросами по
+     * порядковому номеру сообщения. Кэш интерфейсов обновляется один раз после всех изменений
+     * (в режиме UpdateMode::Events - по уведомлениям, без полного дампа). Изменение, подтверждение
+     * которого не получено за отведённое время, завершается ошибкой ETIMEDOUT, а при переполнении
+     * приёмного буфера - ENOBUFS; применено ли оно ядром, в этом случае неизвестно.
+     * @param changes Изменения; интерфейс может встречаться несколько раз, изменения применяются по порядку.
+     * @return Результаты в порядке changes; ошибка одного изменения не прерывает остальные.
+     * @throw exceptions::InterfaceOperationEx если не удалось отправить запросы.
+     */
+    virtual std::vector<InterfaceChangeResult> set_interfaces_state(std::vector<InterfaceStateChange> const &changes) = 0;
     /**
      * @brief Получает подробную информацию о конкретном сетевом интерфейсе.
+     *
+     * Незапрошенные секции не вычисляются и не сериализуются; если не запрошены секции
+     * ip, routes или neigh, соответствующие кэши не просматриваются.
      * @param interface_name Имя интерфейса, о котором нужно получить информацию.
+     * @param sections Маска секций, включаемых в ответ.
      * @return JSON-объект с детальной информацией об интерфейсе.
      */
-    virtual ::nlohmann::json get_interface_info(std::string const &interface_name) = 0;
+    virtual ::nlohmann::json get_interface_info(std::string const &interface_name, Section sections = Section::All) = 0;
     /**
      * @brief Получает список всех доступных сетевых интерфейсов в текущем пространстве имен.
      * @return JSON-объект со списком интерфейсов.
      */
     virtual ::nlohmann::json get_all_interfaces() = 0;
+    /**
+     * @brief Получает подробную информацию обо всех интерфейсах текущего пространства имен.
+     *
+     * Каждый кэш группируется по интерфейсам один раз, поэтому время сбора линейно
+     * зависит от числа интерфейсов, адресов, маршрутов и соседей.
+     * @param sections Маска секций, включаемых в ответ.
+     * @return JSON-объект вида {"interfaces": [...]}, где элементы совпадают с результатом get_interface_info.
+     */
+    virtual ::nlohmann::json get_all_interfaces_info(Section sections = Section::All) = 0;
+    /**
+     * @brief Получает подробную информацию об интерфейсах из списка.
+     * @param interface_names Имена интерфейсов.
+     * @param sections Маска секций, включаемых в ответ.
+     * @return JSON-объект вида {"interfaces": [...]} в порядке имён; для ненайденного интерфейса элемент содержит "error".
+     */
+    virtual ::nlohmann::json get_interfaces_info(std::vector<std::string> const &interface_names, Section sections = Section::All) = 0;
+    /**
+     * @brief Получает подробную информацию об интерфейсе в виде структуры, без построения JSON.
+     * @param interface_name Имя сетевого интерфейса.
+     * @param sections Маска заполняемых секций; остальные поля остаются значениями по умолчанию.
+     * @return Структура с информацией об интерфейсе.
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден.
+     */
+    virtual Json get_interface_data(std::string const &interface_name, Section sections = Section::All) = 0;
+    /**
+     * @brief Получает подробную информацию обо всех интерфейсах в виде структур, без построения JSON.
+     * @param sections Маска заполняемых секций.
+     * @return Структуры в порядке кэша интерфейсов.
+     */
+    virtual std::vector<Json> get_all_interfaces_data(Section sections = Section::All) = 0;
+    /**
+     * @brief Получает подробную информацию об интерфейсах из списка в виде структур, без построения JSON.
+     * @param interface_names Имена интерфейсов.
+     * @param sections Маска заполняемых секций.
+     * @return Структуры в порядке имён.
+     * @throw exceptions::InterfaceNotFound если хотя бы один интерфейс не найден.
+     */
+    virtual std::vector<Json> get_interfaces_data(std::vector<std::string> const &interface_names, Section sections = Section::All) = 0;
+    /**
+     * @brief Возвращает файловый дескриптор для ожидания уведомлений ядра (poll/epoll).
+     * @return Дескриптор сокета уведомлений в режиме UpdateMode::Events, иначе -1.
+     */
+    [[nodiscard]] virtual int get_event_fd() const = 0;
+    /**
+     * @brief Приводит кэши в актуальное состояние.
+     *
+     * В режиме UpdateMode::Events применяет накопившиеся уведомления ядра (ожидая их не дольше
+     * timeout_ms миллисекунд), не выполняя полных дампов. В режиме UpdateMode::Snapshot
+     * перезагружает все кэши полным дампом, timeout_ms игнорируется. Счётчики rx/tx в режиме
+     * UpdateMode::Events не обновляются (см. UpdateMode::Events). Если менеджер кэшей не смог
+     * применить уведомление, загруженные кэши перезагружаются полным дампом, после чего бросается
+     * исключение: события из потерянных уведомлений подписчикам не доставляются.
+     * @param timeout_ms Максимальное время ожидания уведомлений (0 - не ждать, -1 - ждать бесконечно).
+     * Ещё не загруженные кэши не затрагиваются.
+     * @return Количество обработанных уведомлений или перезагруженных кэшей.
+     * @throw std::runtime_error если обновление не удалось.
+     */
+    virtual int refresh(int timeout_ms) = 0;
+    /**
+     * @brief Загружает указанные кэши полным дампом (уже загруженные - перезагружает).
+     *
+     * В режиме UpdateMode::Events впервые загруженный кэш сразу подписывается на уведомления ядра.
+     * @param caches Битовая маска кэшей.
+     * @throw std::runtime_error если загрузка не удалась.
+     */
+    virtual void load_caches(Cache caches) = 0;
+    /**
+     * @brief Подписывается на типизированные события об изменениях.
+     *
+     * События строятся из уведомлений ядра в порядке их поступления, поэтому кратковременные
+     * изменения (например, выключение и включение интерфейса между двумя опросами) не теряются.
+     * Обработчики вызываются синхронно в потоке, применяющем уведомления: внутри refresh(), а также
+     * enable_interface, disable_interface и set_interfaces_state. Дескриптор get_event_fd() становится
+     * готовым к чтению при появлении уведомлений и служит дескриптором подписки в цикле poll/epoll.
+     * Кэши, нужные для событий маски, загружаются при подписке. Исключения обработчика перехватываются
+     * и отбрасываются, чтобы не прерывать доставку остальных событий и вызвавший её метод.
+     * @param events Маска событий.
+     * @param callback Обработчик событий.
+     * @return Идентификатор подписки.
+     * @throw exceptions::InterfaceOperationEx если экземпляр создан не в режиме UpdateMode::Events.
+     */
+    virtual int subscribe(Event events, InterfaceEventCallback callback) = 0;
+    /**
+     * @brief Отменяет подписку; неизвестный идентификатор игнорируется.
+     * @param subscription Идентификатор, полученный от subscribe.
+     */
+    virtual void unsubscribe(int subscription) = 0;
+    /**
+     * @brief Находит маршрут, по которому ядро отправило бы трафик на адрес (аналог `ip route get`).
+     *
+     * Поиск выполняется по наибольшему совпадению префикса в индексе, построенном из кэша маршрутов
+     * при первом вызове; в режиме UpdateMode::Events индекс обновляется по уведомлениям без перестроения.
+     * Среди маршрутов одного префикса выбирается маршрут с наименьшей метрикой. Правила
+     * маршрутизации (ip rule), TOS и метки пакетов не учитываются.
+     * @param address Адрес IPv4 или IPv6 без длины префикса.
+     * @param table Таблица маршрутизации; 0 - таблицы local, main и default по порядку правил по умолчанию
+     *        (маршрут THROW передаёт поиск следующей таблице).
+     * @return Найденный маршрут или std::nullopt, если адрес недостижим.
+     * @throw exceptions::InvalidAddress если address не является адресом IPv4 или IPv6.
+     * @throw exceptions::OutOfScope если задано ограничение DumpScope по интерфейсу, семейство address
+     *        не совпадает с ограничением или table не совпадает с ограничением по таблице.
+     */
+    virtual std::optional<RouteMatch> lookup_route(std::string const &address, uint32_t table = 0) = 0;
+    /**
+     * @brief Находит запись ARP/NDP по интерфейсу и IP-адресу.
+     *
+     * Поиск выполняется по хеш-индексу (ifindex, IP), построенному из кэша соседей при первом вызове;
+     * в режиме UpdateMode::Events индекс обновляется по уведомлениям без перестроения.
+     * @param interface_name Имя интерфейса.
+     * @param address Адрес IPv4 или IPv6.
+     * @return Запись или std::nullopt, если соседа нет в таблице.
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден.
+     * @throw exceptions::InvalidAddress если address не является адресом IPv4 или IPv6.
+     */
+    virtual std::optional<NeighbourEntry> get_neighbour(std::string const &interface_name, std::string const &address) = 0;
+    /**
+     * @brief Выполняет выборочный дамп таблиц ARP/NDP, не затрагивая кэш соседей.
+     *
+     * Интерфейс и семейство передаются ядру в запросе (NDA_IFINDEX, ndm_family), и записи других
+     * интерфейсов не передаются вовсе. Ядро не умеет фильтровать по состоянию, поэтому состояние
+     * проверяется по заголовку сообщения до разбора: объекты строятся только для подходящих записей.
+     * @param filter Условия выборки.
+     * @return Подходящие записи в порядке дампа.
+     * @throw exceptions::InterfaceNotFound если интерфейс фильтра не найден.
+     * @throw exceptions::GetDataNeigh если не удалось выполнить дамп.
+     */
+    virtual std::vector<NeighbourEntry> get_neighbours(NeighbourFilter const &filter) = 0;
     /**
      * @brief Переключается в указанное сетевое пространство имен.
      * @param name Имя сетевого пространства имен.
@@ -96,18 +520,76 @@ class InformerNetlink {
     static ::nlohmann::json get_network_namespaces();
     /**
      * @brief Создает экземпляр класса-наследника InformerNetlink.
+     * @param options Параметры создания.
      * @return Умный указатель на созданный объект.
      * @throw std::runtime_error Если не удалось создать объект.
      */
-    static std::unique_ptr<InformerNetlink> create();
+    static std::unique_ptr<InformerNetlink> create(InformerOptions const &options = {});
+    /**
+     * @brief Создает экземпляр, привязанный к именованному сетевому пространству имен.
+     *
+     * Сокеты Netlink открываются внутри пространства имен из /var/run/netns, после чего вызывающий
+     * поток возвращается в исходное пространство имен. Все дальнейшие запросы и операции экземпляра
+     * выполняются в пространстве имен, в котором он создан, из любого потока и без вызова setns.
+     * @param name Имя пространства имен.
+     * @param options Параметры создания.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если пространство имен не найдено или не удалось создать объект.
+     */
+    static std::unique_ptr<InformerNetlink> create_in_namespace(std::string const &name, InformerOptions const &options = {});
+    /**
+     * @brief Создает экземпляр, привязанный к сетевому пространству имен, заданному дескриптором.
+     * @param namespace_fd Дескриптор пространства имен (например, /proc/<pid>/ns/net); владение не передаётся.
+     * @param options Параметры создания.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось переключиться в пространство имен или создать объект.
+     */
+    static std::unique_ptr<InformerNetlink> create_in_namespace(int namespace_fd, InformerOptions const &options = {});
+    /**
+     * @brief Создает экземпляр, читающий данные из записанного дампа (см. record_netlink_dump).
+     *
+     * Экземпляр не обращается к ядру и не требует прав root: каждое обновление кэша заново разбирает
+     * записанные сообщения. Поддерживается только UpdateMode::Snapshot; изменение интерфейсов и
+     * подписка на события недоступны (exceptions::InterfaceOperationEx).
+     * @param path Путь к файлу дампа.
+     * @param options Параметры создания.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если файл не удалось прочитать, он повреждён или не удалось создать объект.
+     */
+    static std::unique_ptr<InformerNetlink> create_from_dump(std::string const &path, InformerOptions const &options = {});
 
    private:
     /**
      * @brief Внутренний метод для создания экземпляра класса-наследника InformerNetlink.
+     * @param options Параметры создания.
      * @param error_message Буфер для сообщения об ошибке в случае неудачи.
      * @return Указатель на созданный объект или nullptr в случае ошибки.
      */
-    static InformerNetlink *create(char *error_message) noexcept;
+    static InformerNetlink *create(InformerOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Внутренний метод для создания экземпляра в именованном пространстве имен.
+     * @param name Имя пространства имен.
+     * @param options Параметры создания.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static InformerNetlink *create_in_namespace(std::string const &name, InformerOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Внутренний метод для создания экземпляра в пространстве имен, заданном дескриптором.
+     * @param namespace_fd Дескриптор пространства имен.
+     * @param options Параметры создания.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static InformerNetlink *create_in_namespace(int namespace_fd, InformerOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Внутренний метод для создания экземпляра из записанного дампа.
+     * @param path Путь к файлу дампа.
+     * @param options Параметры создания.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static InformerNetlink *create_from_dump(std::string const &path, InformerOptions const &options, char *error_message) noexcept;
     /**
      * @brief Максимальный размер буфера для сообщений об ошибках.
      */
@@ -116,13 +598,68 @@ class InformerNetlink {
 
 /**
  * @brief Создает экземпляр класса-наследника InformerNetlink.
+ * @param options Параметры создания.
  * @return Умный указатель на созданный объект.
  * @throw std::runtime_error Если не удалось создать объект.
  */
-inline std::unique_ptr<InformerNetlink> InformerNetlink::create() {
+inline std::unique_ptr<InformerNetlink> InformerNetlink::create(InformerOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    InformerNetlink *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<InformerNetlink>{new_object};
+}
+
+/**
+ * @brief Создает экземпляр, привязанный к именованному сетевому пространству имен.
+ * @param name Имя пространства имен.
+ * @param options Параметры создания.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если пространство имен не найдено или не удалось создать объект.
+ */
+inline std::unique_ptr<InformerNetlink> InformerNetlink::create_in_namespace(std::string const &name, InformerOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    InformerNetlink *new_object = create_in_namespace(name, options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<InformerNetlink>{new_object};
+}
+
+/**
+ * @brief Создает экземпляр, привязанный к сетевому пространству имен, заданному дескриптором.
+ * @param namespace_fd Дескриптор пространства имен.
+ * @param options Параметры создания.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось переключиться в пространство имен или создать объект.
+ */
+inline std::unique_ptr<InformerNetlink> InformerNetlink::create_in_namespace(int const namespace_fd, InformerOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    InformerNetlink *new_object = create_in_namespace(namespace_fd, options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<InformerNetlink>{new_object};
+}
+
+/**
+ * @brief Создает экземпляр, читающий данные из записанного дампа.
+ * @param path Путь к файлу дампа.
+ * @param options Параметры создания.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если файл не удалось прочитать, он повреждён или не удалось создать объект.
+ */
+inline std::unique_ptr<InformerNetlink> InformerNetlink::create_from_dump(std::string const &path, InformerOptions const &options) {
     auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
 
-    InformerNetlink *new_object = create(message_error.get());
+    InformerNetlink *new_object = create_from_dump(path, options, message_error.get());
     if (new_object == nullptr) {
         throw std::runtime_error(message_error.get());
     }
@@ -0,0 +1,69 @@
+/**
+ * @file json_writer.hpp
+ * @brief Потоковая сериализация информации об интерфейсах в JSON без построения nlohmann::json.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct JsonWriterEx
+ * @brief Исключение при ошибке записи JSON в файловый дескриптор
+ */
+struct JsonWriterEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @brief Дописывает JSON-представление интерфейса в конец строки.
+ *
+ * Если все строки - корректный UTF-8, результат побайтно совпадает с get_interface_info(name, sections).dump():
+ * ключи упорядочены так же, как в nlohmann::json, незапрошенные секции не выводятся. Некорректные
+ * последовательности UTF-8 (например, в псевдониме интерфейса) выводятся без изменений, тогда как
+ * dump() для них выбрасывает nlohmann::json::type_error.
+ * @param out Строка, в конец которой выполняется запись.
+ * @param info Информация об интерфейсе.
+ * @param sections Маска выводимых секций.
+ */
+void write_json(std::string &out, Json const &info, Section sections = Section::All);
+/**
+ * @brief Дописывает JSON-объект вида {"interfaces": [...]} в конец строки.
+ *
+ * Для строк в корректном UTF-8 результат побайтно совпадает с get_all_interfaces_info(sections).dump()
+ * для тех же интерфейсов (см. write_json(std::string &, Json const &, Section)).
+ * @param out Строка, в конец которой выполняется запись.
+ * @param interfaces Информация об интерфейсах.
+ * @param sections Маска выводимых секций.
+ */
+void write_json(std::string &out, std::vector<Json> const &interfaces, Section sections = Section::All);
+/**
+ * @brief Записывает JSON-представление интерфейса в файловый дескриптор.
+ * @param fd Открытый на запись файловый дескриптор.
+ * @param info Информация об интерфейсе.
+ * @param sections Маска выводимых секций.
+ * @throw exceptions::JsonWriterEx если запись не удалась.
+ */
+void write_json(int fd, Json const &info, Section sections = Section::All);
+/**
+ * @brief Записывает JSON-объект вида {"interfaces": [...]} в файловый дескриптор.
+ *
+ * Данные сбрасываются в дескриптор порциями по мере заполнения внутреннего буфера, поэтому
+ * объём памяти не зависит от числа интерфейсов.
+ * @param fd Открытый на запись файловый дескриптор.
+ * @param interfaces Информация об интерфейсах.
+ * @param sections Маска выводимых секций.
+ * @throw exceptions::JsonWriterEx если запись не удалась.
+ */
+void write_json(int fd, std::vector<Json> const &interfaces, Section sections = Section::All);
+
+} // namespace os::network
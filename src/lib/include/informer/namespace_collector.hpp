@@ -0,0 +1,104 @@
+/**
+ * @file namespace_collector.hpp
+ * @brief Параллельный сбор информации об интерфейсах из множества сетевых пространств имен.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+/**
+ * @struct NamespaceSnapshot
+ * @brief Информация об интерфейсах одного сетевого пространства имен.
+ */
+struct NamespaceSnapshot {
+    std::string name{};             /**< Имя пространства имен */
+    std::vector<Json> interfaces{}; /**< Интерфейсы пространства имен */
+    std::string error{};            /**< Сообщение об ошибке сбора (пустое при успехе) */
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(NamespaceSnapshot, name, interfaces, error);
+
+/**
+ * @struct CollectorOptions
+ * @brief Параметры создания NamespaceCollector.
+ */
+struct CollectorOptions {
+    std::size_t workers{0}; /**< Количество рабочих потоков (0 - по числу ядер) */
+};
+
+/**
+ * @class NamespaceCollector
+ * @brief Абстрактный класс параллельного сборщика информации из сетевых пространств имен.
+ *
+ * Рабочие потоки запускаются на время вызова collect() и берут пространства имен из списка по одному,
+ * по мере освобождения. Для каждого пространства имен поток создаёт собственный экземпляр
+ * InformerNetlink::create_in_namespace (setns действует только на поток и отменяется сразу после
+ * открытия сокетов) и снимает данные.
+ * Вызывающий поток пространство имен не меняет.
+ */
+class NamespaceCollector {
+   public:
+    NamespaceCollector() = default;
+    virtual ~NamespaceCollector() = default;
+
+    NamespaceCollector(NamespaceCollector const &) = delete;
+    NamespaceCollector(NamespaceCollector &&) = delete;
+    NamespaceCollector &operator=(NamespaceCollector const &) = delete;
+    NamespaceCollector &operator=(NamespaceCollector &&) = delete;
+
+    /**
+     * @brief Собирает информацию об интерфейсах из указанных пространств имен.
+     * @param namespaces Имена пространств имен из /var/run/netns (например, из get_network_namespaces).
+     * @param sections Маска собираемых секций; кэши для незапрошенных секций не загружаются.
+     * @return Снимки в порядке имён; ошибка сбора одного пространства имен записывается в его поле error.
+     */
+    virtual std::vector<NamespaceSnapshot> collect(std::vector<std::string> const &namespaces,
+                                                   Section sections = Section::All) = 0;
+    /**
+     * @brief Создает экземпляр класса-наследника NamespaceCollector.
+     * @param options Параметры сборщика.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<NamespaceCollector> create(CollectorOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника NamespaceCollector.
+     * @param options Параметры сборщика.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static NamespaceCollector *create(CollectorOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника NamespaceCollector.
+ * @param options Параметры сборщика.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<NamespaceCollector> NamespaceCollector::create(CollectorOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    NamespaceCollector *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<NamespaceCollector>{new_object};
+}
+} // namespace os::network
@@ -0,0 +1,175 @@
+/**
+ * @file namespace_registry.hpp
+ * @brief Реестр именованных сетевых пространств имен с открытыми дескрипторами и обновлением через inotify.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+/**
+ * @class NetNamespaceHandle
+ * @brief Открытый дескриптор сетевого пространства имен; дескриптор закрывается при разрушении.
+ */
+class NetNamespaceHandle final {
+   public:
+    /**
+     * @brief Конструктор, принимающий владение дескриптором.
+     * @param fd Дескриптор файла nsfs.
+     * @param device Номер устройства файловой системы nsfs.
+     * @param inode Номер inode пространства имен.
+     */
+    NetNamespaceHandle(int fd, uint64_t device, uint64_t inode) noexcept;
+    ~NetNamespaceHandle();
+
+    NetNamespaceHandle(NetNamespaceHandle const &) = delete;
+    NetNamespaceHandle(NetNamespaceHandle &&) = delete;
+    NetNamespaceHandle &operator=(NetNamespaceHandle const &) = delete;
+    NetNamespaceHandle &operator=(NetNamespaceHandle &&) = delete;
+
+    /**
+     * @brief Дескриптор пространства имен (например, для InformerNetlink::create_in_namespace).
+     */
+    [[nodiscard]] int fd() const noexcept { return m_fd; }
+    /**
+     * @brief Номер inode пространства имен; совпадает у всех имён одного пространства имен.
+     */
+    [[nodiscard]] uint64_t inode() const noexcept { return m_inode; }
+    /**
+     * @brief Номер устройства; пространство имен однозначно определяет пара (device(), inode()).
+     */
+    [[nodiscard]] uint64_t device() const noexcept { return m_device; }
+
+   private:
+    int m_fd{-1};        /**< Дескриптор */
+    uint64_t m_device{}; /**< Номер устройства */
+    uint64_t m_inode{};  /**< Номер inode */
+};
+
+/**
+ * @struct NetNamespaceEntry
+ * @brief Уникальное пространство имен и все имена, под которыми оно смонтировано.
+ */
+struct NetNamespaceEntry {
+    std::vector<std::string> names{};                   /**< Имена в каталоге пространств имен */
+    std::shared_ptr<NetNamespaceHandle const> handle{}; /**< Открытый дескриптор */
+};
+
+/**
+ * @struct RegistryOptions
+ * @brief Параметры создания NamespaceRegistry.
+ */
+struct RegistryOptions {
+    std::string directory{"/var/run/netns"}; /**< Каталог именованных пространств имен */
+};
+
+/**
+ * @class NamespaceRegistry
+ * @brief Абстрактный класс реестра именованных сетевых пространств имен.
+ *
+ * Реестр держит открытым по одному дескриптору на пространство имен (имена, указывающие на одно
+ * пространство имен, объединяются по паре устройство и inode nsfs) и обновляется по событиям inotify каталога,
+ * поэтому получение списка и переключение не обращаются к файловой системе. Файл, созданный
+ * `ip netns add`, ещё не является точкой монтирования nsfs в момент события IN_CREATE; такие
+ * имена проверяются повторно при каждом refresh(), пока монтирование не появится.
+ *
+ * Методы чтения можно вызывать из любых потоков параллельно с refresh().
+ */
+class NamespaceRegistry {
+   public:
+    NamespaceRegistry() = default;
+    virtual ~NamespaceRegistry() = default;
+
+    NamespaceRegistry(NamespaceRegistry const &) = delete;
+    NamespaceRegistry(NamespaceRegistry &&) = delete;
+    NamespaceRegistry &operator=(NamespaceRegistry const &) = delete;
+    NamespaceRegistry &operator=(NamespaceRegistry &&) = delete;
+
+    /**
+     * @brief Получает список имён пространств имен из памяти.
+     * @return JSON-объект в формате InformerNetlink::get_network_namespaces.
+     */
+    [[nodiscard]] virtual ::nlohmann::json get_network_namespaces() const = 0;
+    /**
+     * @brief Получает имена всех известных пространств имен.
+     * @return Имена в лексикографическом порядке.
+     */
+    [[nodiscard]] virtual std::vector<std::string> get_names() const = 0;
+    /**
+     * @brief Получает уникальные пространства имен с их именами.
+     * @return Пространства имен без повторов.
+     */
+    [[nodiscard]] virtual std::vector<NetNamespaceEntry> get_namespaces() const = 0;
+    /**
+     * @brief Ищет пространство имен по имени.
+     * @param name Имя пространства имен.
+     * @return Дескриптор, остающийся открытым, пока на него есть ссылки, или nullptr, если имя неизвестно.
+     */
+    [[nodiscard]] virtual std::shared_ptr<NetNamespaceHandle const> find(std::string const &name) const = 0;
+    /**
+     * @brief Переключает вызывающий поток в пространство имен по сохранённому дескриптору.
+     * @param name Имя пространства имен.
+     * @throw exceptions::OpenNamespace если имя неизвестно.
+     * @throw exceptions::SwitchNamespace если не удалось переключиться.
+     */
+    virtual void switch_to_namespace(std::string const &name) const = 0;
+    /**
+     * @brief Возвращает дескриптор inotify для ожидания изменений каталога (poll/epoll).
+     * @return Дескриптор inotify.
+     */
+    [[nodiscard]] virtual int get_event_fd() const = 0;
+    /**
+     * @brief Применяет накопившиеся события inotify и повторно проверяет ожидающие монтирования имена.
+     * @param timeout_ms Максимальное время ожидания событий (0 - не ждать, -1 - ждать бесконечно).
+     * @return Количество добавленных и удалённых имён.
+     */
+    virtual int refresh(int timeout_ms) = 0;
+    /**
+     * @brief Создает экземпляр класса-наследника NamespaceRegistry.
+     * @param options Параметры реестра.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<NamespaceRegistry> create(RegistryOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника NamespaceRegistry.
+     * @param options Параметры реестра.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static NamespaceRegistry *create(RegistryOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника NamespaceRegistry.
+ * @param options Параметры реестра.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<NamespaceRegistry> NamespaceRegistry::create(RegistryOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    NamespaceRegistry *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<NamespaceRegistry>{new_object};
+}
+} // namespace os::network
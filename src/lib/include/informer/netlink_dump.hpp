@@ -0,0 +1,69 @@
+/**
+ * @file netlink_dump.hpp
+ * @brief Запись дампов RTM_NEWLINK/NEWADDR/NEWROUTE/NEWNEIGH в файл для последующего воспроизведения.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct NetlinkDumpEx
+ * @brief Исключение при ошибке записи или чтения файла дампа
+ */
+struct NetlinkDumpEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @brief Сигнатура файла дампа ("IIDUMP" в младших байтах).
+ */
+inline constexpr uint64_t NETLINK_DUMP_MAGIC = 0x0000504D55444949ull;
+/**
+ * @brief Версия формата файла дампа.
+ */
+inline constexpr uint32_t NETLINK_DUMP_VERSION = 1;
+
+/**
+ * @struct NetlinkDumpHeader
+ * @brief Заголовок файла дампа.
+ *
+ * За заголовком подряд следуют сообщения Netlink в том виде, в котором их вернуло ядро (каждое
+ * выровнено по NLMSG_ALIGNTO). Порядок байтов - порядок узла, на котором сделана запись.
+ */
+struct NetlinkDumpHeader {
+    uint64_t magic{NETLINK_DUMP_MAGIC};     /**< Сигнатура NETLINK_DUMP_MAGIC */
+    uint32_t version{NETLINK_DUMP_VERSION}; /**< Версия формата */
+    uint32_t caches{};                      /**< Маска записанных кэшей (Cache) */
+};
+
+/**
+ * @brief Записывает дампы кэшей текущего сетевого пространства имен в файл.
+ *
+ * Файл готовится под временным именем и заменяет прежний целиком. Записанный дамп загружается
+ * через InformerNetlink::create_from_dump без прав root и без обращения к ядру.
+ * @param path Путь к файлу дампа.
+ * @param caches Маска записываемых кэшей.
+ * @throw exceptions::NetlinkDumpEx если не удалось получить дамп или записать файл.
+ */
+void record_netlink_dump(std::string const &path, Cache caches = Cache::All);
+/**
+ * @brief Записывает дампы кэшей пространства имен, заданного дескриптором, в файл.
+ * @param path Путь к файлу дампа.
+ * @param namespace_fd Дескриптор пространства имен; владение не передаётся.
+ * @param caches Маска записываемых кэшей.
+ * @throw exceptions::NetlinkDumpEx если не удалось получить дамп или записать файл.
+ * @throw exceptions::OpenNamespace, exceptions::SwitchNamespace если не удалось переключиться в пространство имен.
+ */
+void record_netlink_dump(std::string const &path, int namespace_fd, Cache caches = Cache::All);
+
+} // namespace os::network
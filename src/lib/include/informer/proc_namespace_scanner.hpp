@@ -0,0 +1,108 @@
+/**
+ * @file proc_namespace_scanner.hpp
+ * @brief Обнаружение сетевых пространств имен процессов через /proc/<pid>/ns/net.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "informer/namespace_registry.hpp"
+
+namespace os::network {
+
+/**
+ * @struct ProcNamespace
+ * @brief Сетевое пространство имен и процессы, находящиеся в нём.
+ */
+struct ProcNamespace {
+    uint64_t inode{};                                   /**< Номер inode пространства имен */
+    std::vector<int> pids{};                            /**< Идентификаторы процессов по возрастанию */
+    std::shared_ptr<NetNamespaceHandle const> handle{}; /**< Открытый дескриптор (nullptr, если открыть не удалось) */
+};
+
+/**
+ * @struct ScannerOptions
+ * @brief Параметры создания ProcNamespaceScanner.
+ */
+struct ScannerOptions {
+    std::string proc_root{"/proc"}; /**< Точка монтирования procfs */
+    std::size_t workers{0};         /**< Количество потоков для проверки новых процессов (0 - по числу ядер) */
+};
+
+/**
+ * @class ProcNamespaceScanner
+ * @brief Абстрактный класс обнаружения сетевых пространств имен по процессам.
+ *
+ * В отличие от InformerNetlink::get_network_namespaces находит и пространства имен, не
+ * смонтированные в /var/run/netns (например, созданные средами выполнения контейнеров).
+ * Сканирование инкрементальное: каталог /proc читается целиком, но ns/net проверяется только
+ * у процессов, появившихся после предыдущего сканирования, причём проверка распределяется по
+ * нескольким потокам. Процесс, сменивший пространство имен после первой проверки (setns/unshare),
+ * и повторно использованный PID учитываются только при полном сканировании.
+ *
+ * Дескриптор пространства имен удерживается, пока в нём есть хотя бы один процесс, и
+ * освобождается сканером (но не держателями ProcNamespace::handle) после их завершения.
+ */
+class ProcNamespaceScanner {
+   public:
+    ProcNamespaceScanner() = default;
+    virtual ~ProcNamespaceScanner() = default;
+
+    ProcNamespaceScanner(ProcNamespaceScanner const &) = delete;
+    ProcNamespaceScanner(ProcNamespaceScanner &&) = delete;
+    ProcNamespaceScanner &operator=(ProcNamespaceScanner const &) = delete;
+    ProcNamespaceScanner &operator=(ProcNamespaceScanner &&) = delete;
+
+    /**
+     * @brief Обновляет сведения о процессах и возвращает найденные пространства имен.
+     * @param full true - проверить заново все процессы, false - только новые.
+     * @return Пространства имен по возрастанию inode; процессы, к ns/net которых нет доступа, не учитываются.
+     * @throw std::runtime_error если не удалось прочитать каталог procfs.
+     */
+    virtual std::vector<ProcNamespace> scan(bool full = false) = 0;
+    /**
+     * @brief Создает экземпляр класса-наследника ProcNamespaceScanner.
+     * @param options Параметры сканера.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<ProcNamespaceScanner> create(ScannerOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника ProcNamespaceScanner.
+     * @param options Параметры сканера.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static ProcNamespaceScanner *create(ScannerOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника ProcNamespaceScanner.
+ * @param options Параметры сканера.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<ProcNamespaceScanner> ProcNamespaceScanner::create(ScannerOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    ProcNamespaceScanner *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<ProcNamespaceScanner>{new_object};
+}
+} // namespace os::network
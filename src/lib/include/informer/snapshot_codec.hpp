@@ -0,0 +1,58 @@
+/**
+ * @file snapshot_codec.hpp
+ * @brief Компактное двоичное кодирование снимка интерфейсов для передачи коллектору.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct DecodeSnapshot
+ * @brief Исключение при разборе повреждённого или несовместимого двоичного снимка
+ */
+struct DecodeSnapshot final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @brief Версия формата двоичного снимка.
+ */
+inline constexpr uint8_t SNAPSHOT_FORMAT_VERSION = 1;
+
+/**
+ * @brief Дописывает двоичный снимок интерфейсов в конец буфера.
+ *
+ * Формат: сигнатура "IFS" и версия, маска секций, таблица строк, затем интерфейсы. Все строки
+ * снимка (типы, состояния, адреса, имена) хранятся в таблице один раз и передаются индексами,
+ * целые числа кодируются varint. Списки флагов general.flags, ip.flags и neigh.type передаются
+ * битовыми масками известных имён; неизвестные имена передаются дополнительно индексами строк.
+ * Секции, не вошедшие в маску, не кодируются.
+ * @param out Буфер, в конец которого выполняется запись.
+ * @param interfaces Информация об интерфейсах.
+ * @param sections Маска кодируемых секций.
+ */
+void encode_snapshot(std::vector<uint8_t> &out, std::vector<Json> const &interfaces, Section sections = Section::All);
+/**
+ * @brief Разбирает двоичный снимок, созданный encode_snapshot.
+ *
+ * Поля секций, не вошедших в снимок, остаются значениями по умолчанию. Известные имена флагов
+ * восстанавливаются в порядке бит маски (в нём их формирует InformerNetlink), повторы известного
+ * имени объединяются, а неизвестные имена следуют за известными в исходном порядке.
+ * @param data Двоичный снимок.
+ * @return Информация об интерфейсах.
+ * @throw exceptions::DecodeSnapshot если данные повреждены или версия формата не поддерживается.
+ */
+std::vector<Json> decode_snapshot(std::span<uint8_t const> data);
+
+} // namespace os::network
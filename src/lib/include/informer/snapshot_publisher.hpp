@@ -0,0 +1,139 @@
+/**
+ * @file snapshot_publisher.hpp
+ * @brief Фоновое построение неизменяемых снимков интерфейсов для параллельного чтения.
+ * @author Roman Khromenko
+ * @copyright 2025
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+/**
+ * @struct InterfaceSnapshot
+ * @brief Неизменяемый снимок информации обо всех интерфейсах.
+ */
+struct InterfaceSnapshot {
+    std::vector<Json> interfaces{};                         /**< Интерфейсы в порядке кэша */
+    std::unordered_map<std::string, std::size_t> by_name{}; /**< Позиция интерфейса по имени */
+    Section sections{Section::All};                         /**< Заполненные секции */
+    uint64_t generation{};                                  /**< Номер снимка, возрастает с каждой публикацией */
+    std::chrono::steady_clock::time_point taken_at{};       /**< Момент построения */
+
+    /**
+     * @brief Ищет интерфейс по имени.
+     * @param name Имя интерфейса.
+     * @return Указатель на данные интерфейса (действителен, пока жив снимок) или nullptr.
+     */
+    [[nodiscard]] Json const *find(std::string const &name) const {
+        auto const it = by_name.find(name);
+        return it != by_name.end() ? &interfaces[it->second] : nullptr;
+    }
+};
+
+/**
+ * @struct PublisherOptions
+ * @brief Параметры создания SnapshotPublisher.
+ */
+struct PublisherOptions {
+    std::chrono::milliseconds interval{1000};     /**< Период перестроения снимка (обновление счётчиков) */
+    Section sections{Section::All};               /**< Секции, включаемые в снимок */
+    UpdateMode update_mode{UpdateMode::Snapshot}; /**< Режим обновления кэшей фонового потока */
+    int namespace_fd{-1};                         /**< Пространство имен (-1 - текущее пространство имен) */
+};
+
+/**
+ * @class SnapshotPublisher
+ * @brief Абстрактный класс издателя снимков интерфейсов.
+ *
+ * Кэши и сокеты принадлежат единственному фоновому потоку, который строит новый снимок и
+ * публикует его заменой указателя. Мьютекс защищает только копирование указателя, поэтому читатели
+ * не ждут построения снимка и могут использовать его сколь угодно долго: опубликованный снимок не изменяется.
+ * В режиме UpdateMode::Events снимок дополнительно перестраивается сразу после уведомлений ядра
+ * (появление и удаление интерфейсов, адресов, маршрутов, соседей), не дожидаясь периода.
+ */
+class SnapshotPublisher {
+   public:
+    SnapshotPublisher() = default;
+    virtual ~SnapshotPublisher() = default;
+
+    SnapshotPublisher(SnapshotPublisher const &) = delete;
+    SnapshotPublisher(SnapshotPublisher &&) = delete;
+    SnapshotPublisher &operator=(SnapshotPublisher const &) = delete;
+    SnapshotPublisher &operator=(SnapshotPublisher &&) = delete;
+
+    /**
+     * @brief Запускает фоновый поток перестроения снимков.
+     */
+    virtual void start() = 0;
+    /**
+     * @brief Останавливает фоновый поток. Последний снимок остаётся доступным.
+     * @throw std::runtime_error если не удалось сбросить дескриптор пробуждения потока.
+     */
+    virtual void stop() = 0;
+    /**
+     * @brief Строит и публикует снимок в вызывающем потоке (при остановленном фоновом потоке).
+     * @throw std::runtime_error если не удалось получить данные.
+     */
+    virtual void publish() = 0;
+    /**
+     * @brief Возвращает текущий снимок. Безопасно вызывать из любого числа потоков одновременно.
+     * @return Указатель на снимок (не nullptr: первый снимок строится при создании).
+     */
+    [[nodiscard]] virtual std::shared_ptr<InterfaceSnapshot const> get_snapshot() const noexcept = 0;
+    /**
+     * @brief Возвращает число сбоев обновления в фоновом потоке.
+     *
+     * Сбой не останавливает поток: читатели получают предыдущий снимок, следующее обновление
+     * выполняется по расписанию. Рост значения означает, что снимок может отставать от состояния ядра.
+     * @return Количество сбоев с момента создания.
+     */
+    [[nodiscard]] virtual uint64_t failed_updates() const noexcept = 0;
+    /**
+     * @brief Создает экземпляр класса-наследника SnapshotPublisher и строит первый снимок.
+     * @param options Параметры издателя.
+     * @return Умный указатель на созданный объект.
+     * @throw std::runtime_error Если не удалось создать объект.
+     */
+    static std::unique_ptr<SnapshotPublisher> create(PublisherOptions const &options = {});
+
+   private:
+    /**
+     * @brief Внутренний метод для создания экземпляра класса-наследника SnapshotPublisher.
+     * @param options Параметры издателя.
+     * @param error_message Буфер для сообщения об ошибке в случае неудачи.
+     * @return Указатель на созданный объект или nullptr в случае ошибки.
+     */
+    static SnapshotPublisher *create(PublisherOptions const &options, char *error_message) noexcept;
+    /**
+     * @brief Максимальный размер буфера для сообщений об ошибках.
+     */
+    static constexpr std::size_t M_MAX_BUFFER_SIZE = 1024;
+};
+
+/**
+ * @brief Создает экземпляр класса-наследника SnapshotPublisher и строит первый снимок.
+ * @param options Параметры издателя.
+ * @return Умный указатель на созданный объект.
+ * @throw std::runtime_error Если не удалось создать объект.
+ */
+inline std::unique_ptr<SnapshotPublisher> SnapshotPublisher::create(PublisherOptions const &options) {
+    auto const message_error = std::make_unique<char[]>(M_MAX_BUFFER_SIZE);
+
+    SnapshotPublisher *new_object = create(options, message_error.get());
+    if (new_object == nullptr) {
+        throw std::runtime_error(message_error.get());
+    }
+
+    return std::unique_ptr<SnapshotPublisher>{new_object};
+}
+} // namespace os::network
@@ -0,0 +1,324 @@
+#include "informer/json_writer.hpp"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string_view>
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @class JsonStreamWriter
+ * @brief Сериализатор структур Json в буфер fmt с необязательным сбросом в файловый дескриптор
+ *
+ * Ключи объектов выводятся в лексикографическом порядке, как их хранит nlohmann::json, а строки
+ * экранируются по тем же правилам, что и nlohmann::json::dump(), поэтому результат совпадает побайтно.
+ */
+class JsonStreamWriter {
+   public:
+    /**
+     * @brief Конструктор
+     * @param fd Дескриптор для сброса буфера или -1, если данные остаются в буфере
+     */
+    explicit JsonStreamWriter(int const fd = -1) : m_fd{fd} {}
+
+    /**
+     * @brief Записывает объект интерфейса
+     * @param info Информация об интерфейсе
+     * @param sections Маска выводимых секций
+     */
+    void write(Json const &info, Section const sections) {
+        bool first = true;
+        raw("{");
+        if (has_section(sections, Section::General)) {
+            member(first, "general");
+            write(info.general);
+        }
+        if (has_section(sections, Section::HW)) {
+            member(first, "hw");
+            write(info.hw);
+        }
+        member(first, "interface");
+        string(info.interface);
+        if (has_section(sections, Section::Ip)) {
+            member(first, "ip");
+            array(info.ip);
+        }
+        if (has_section(sections, Section::Neigh)) {
+            member(first, "neigh");
+            array(info.neigh);
+        }
+        if (has_section(sections, Section::OperationalStatus)) {
+            member(first, "operational_status");
+            write(info.operational_status);
+        }
+        if (has_section(sections, Section::Protocols)) {
+            member(first, "protocols");
+            write(info.protocols);
+        }
+        if (has_section(sections, Section::Routes)) {
+            member(first, "routes");
+            array(info.routes);
+        }
+        if (has_section(sections, Section::Rx)) {
+            member(first, "rx");
+            write(info.rx);
+        }
+        if (has_section(sections, Section::Tx)) {
+            member(first, "tx");
+            write(info.tx);
+        }
+        raw("}");
+        flush_if_full();
+    }
+    /**
+     * @brief Записывает объект вида {"interfaces": [...]}
+     * @param interfaces Информация об интерфейсах
+     * @param sections Маска выводимых секций
+     */
+    void write(std::vector<Json> const &interfaces, Section const sections) {
+        raw(R"({"interfaces":[)");
+        for (std::size_t i = 0; i < interfaces.size(); ++i) {
+            if (i != 0) {
+                raw(",");
+            }
+            write(interfaces[i], sections);
+        }
+        raw("]}");
+    }
+    /**
+     * @brief Возвращает накопленные данные
+     */
+    [[nodiscard]] ::fmt::memory_buffer const &buffer() const noexcept { return m_buffer; }
+    /**
+     * @brief Сбрасывает накопленные данные в дескриптор
+     * @throw exceptions::JsonWriterEx если запись не удалась
+     */
+    void flush() {
+        char const *data = m_buffer.data();
+        std::size_t left = m_buffer.size();
+        while (left > 0) {
+            ssize_t const written = ::write(m_fd, data, left);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw exceptions::JsonWriterEx(::fmt::format("Write JSON to fd {}: {}", m_fd, std::strerror(errno)));
+            }
+            data += written;
+            left -= static_cast<std::size_t>(written);
+        }
+        m_buffer.clear();
+    }
+
+   private:
+    void write(Packetometr const &value) {
+        raw(R"({"bytes":)");
+        number(value.bytes);
+        raw(R"(,"drops":)");
+        number(value.drops);
+        raw(R"(,"errors":)");
+        number(value.errors);
+        raw(R"(,"packets":)");
+        number(value.packets);
+        raw("}");
+    }
+    void write(Neigh const &value) {
+        raw(R"({"ip":)");
+        string(value.ip);
+        raw(R"(,"mac":)");
+        string(value.mac);
+        raw(R"(,"type":)");
+        array(value.type);
+        raw("}");
+    }
+    void write(Routes const &value) {
+        raw(R"({"destination":)");
+        string(value.destination);
+        raw(R"(,"gateway":)");
+        string(value.gateway);
+        raw(R"(,"metric":)");
+        number(value.metric);
+        raw(R"(,"table":)");
+        number(value.table);
+        raw(R"(,"type":)");
+        string(value.type);
+        raw("}");
+    }
+    void write(Ip const &value) {
+        raw(R"({"broadcast":)");
+        string(value.broadcast);
+        raw(R"(,"flags":)");
+        array(value.flags);
+        raw(R"(,"ip":)");
+        string(value.ip);
+        raw(R"(,"masc":)");
+        number(value.masc);
+        raw(R"(,"peer":)");
+        string(value.peer);
+        raw(R"(,"pref_lft":)");
+        number(value.pref_lft);
+        raw(R"(,"type":)");
+        string(value.type);
+        raw(R"(,"valid_lft":)");
+        number(value.valid_lft);
+        raw("}");
+    }
+    void write(Protocols const &value) {
+        raw(R"({"multicast":)");
+        raw(value.multicast ? "true" : "false");
+        raw(R"(,"routing_ipv4":)");
+        raw(value.routing_ipv4 ? "true" : "false");
+        raw("}");
+    }
+    void write(OperationalStatus const &value) {
+        raw(R"({"link_mode":)");
+        string(value.link_mode);
+        raw(R"(,"oper_state":)");
+        string(value.oper_state);
+        raw("}");
+    }
+    void write(HW const &value) {
+        raw(R"({"mac":)");
+        array(value.mac);
+        raw(R"(,"mtu":)");
+        number(value.mtu);
+        raw(R"(,"size_queue":)");
+        number(value.size_queue);
+        raw(R"(,"type":)");
+        string(value.type);
+        raw("}");
+    }
+    void write(General const &value) {
+        raw(R"({"flags":)");
+        array(value.flags);
+        raw(R"(,"index":)");
+        number(value.index);
+        raw(R"(,"state":)");
+        string(value.state);
+        raw(R"(,"type":)");
+        string(value.type);
+        raw("}");
+    }
+    void write(std::string const &value) { string(value); }
+
+    template <typename T>
+    void array(std::vector<T> const &values) {
+        raw("[");
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i != 0) {
+                raw(",");
+            }
+            write(values[i]);
+        }
+        raw("]");
+    }
+    template <typename T>
+    void number(T const value) {
+        ::fmt::format_int const text(value);
+        m_buffer.append(text.data(), text.data() + text.size());
+    }
+    void member(bool &first, std::string_view const key) {
+        if (!first) {
+            raw(",");
+        }
+        first = false;
+        raw("\"");
+        raw(key);
+        raw("\":");
+    }
+    void raw(std::string_view const text) { m_buffer.append(text.data(), text.data() + text.size()); }
+    /**
+     * @brief Записывает строку в кавычках с экранированием как в nlohmann::json::dump()
+     *
+     * Байты старше 0x7F выводятся без изменений (ensure_ascii = false) и без проверки UTF-8, поэтому
+     * некорректная последовательность попадает в вывод как есть, а не приводит к исключению, как в dump().
+     */
+    void string(std::string_view const text) {
+        raw("\"");
+        std::size_t run = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            auto const byte = static_cast<unsigned char>(text[i]);
+            std::string_view escape;
+            switch (byte) {
+                case '"':
+                    escape = R"(\")";
+                    break;
+                case '\\':
+                    escape = R"(\\)";
+                    break;
+                case '\b':
+                    escape = R"(\b)";
+                    break;
+                case '\f':
+                    escape = R"(\f)";
+                    break;
+                case '\n':
+                    escape = R"(\n)";
+                    break;
+                case '\r':
+                    escape = R"(\r)";
+                    break;
+                case '\t':
+                    escape = R"(\t)";
+                    break;
+                default:
+                    if (byte > 0x1F) {
+                        continue;
+                    }
+                    break;
+            }
+            raw(text.substr(run, i - run));
+            run = i + 1;
+            if (escape.empty()) {
+                ::fmt::format_to(std::back_inserter(m_buffer), "\\u{:04x}", byte);
+            } else {
+                raw(escape);
+            }
+        }
+        raw(text.substr(run));
+        raw("\"");
+    }
+    void flush_if_full() {
+        if (m_fd >= 0 && m_buffer.size() >= M_FLUSH_SIZE) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Объём буфера, после которого данные сбрасываются в дескриптор
+     */
+    static constexpr std::size_t M_FLUSH_SIZE = 64 * 1024;
+
+    ::fmt::memory_buffer m_buffer{}; /**< Буфер вывода */
+    int m_fd{-1};                    /**< Дескриптор для сброса буфера */
+};
+
+} // namespace
+
+void write_json(std::string &out, Json const &info, Section const sections) {
+    JsonStreamWriter writer;
+    writer.write(info, sections);
+    out.append(writer.buffer().data(), writer.buffer().size());
+}
+void write_json(std::string &out, std::vector<Json> const &interfaces, Section const sections) {
+    JsonStreamWriter writer;
+    writer.write(interfaces, sections);
+    out.append(writer.buffer().data(), writer.buffer().size());
+}
+void write_json(int const fd, Json const &info, Section const sections) {
+    JsonStreamWriter writer(fd);
+    writer.write(info, sections);
+    writer.flush();
+}
+void write_json(int const fd, std::vector<Json> const &interfaces, Section const sections) {
+    JsonStreamWriter writer(fd);
+    writer.write(interfaces, sections);
+    writer.flush();
+}
+
+} // namespace os::network
@@ -0,0 +1,74 @@
+#include "namespace_guard.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "informer/interface_informer.hpp"
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @brief Сохраняет текущее пространство имен потока и переключается в заданное
+ * @param namespace_fd Дескриптор целевого пространства имен
+ * @return Дескриптор исходного пространства имен
+ */
+int enter_namespace(int const namespace_fd) {
+    int const saved_fd = ::open("/proc/thread-self/ns/net", O_RDONLY | O_CLOEXEC);
+    if (saved_fd < 0) {
+        throw exceptions::OpenNamespace(::fmt::format("Open current namespace: {}", std::strerror(errno)));
+    }
+
+    if (::setns(namespace_fd, CLONE_NEWNET) != 0) {
+        int const error = errno;
+        ::close(saved_fd);
+        throw exceptions::SwitchNamespace(::fmt::format("Switch namespace: {}", std::strerror(error)));
+    }
+    return saved_fd;
+}
+
+/**
+ * @brief Сохраняет текущее пространство имен потока и переключается в именованное
+ * @param name Имя пространства имен в /var/run/netns
+ * @return Дескриптор исходного пространства имен
+ */
+int enter_named_namespace(std::string const &name) {
+    std::string const path = "/var/run/netns/" + name;
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw exceptions::OpenNamespace(::fmt::format("Open namespace {}", name));
+    }
+
+    try {
+        int const saved_fd = enter_namespace(fd);
+        ::close(fd);
+        return saved_fd;
+    } catch (exceptions::SwitchNamespace const &) {
+        ::close(fd);
+        throw exceptions::SwitchNamespace(::fmt::format("Switch namespace {}", name));
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+} // namespace
+
+NetNamespaceGuard::NetNamespaceGuard(int const namespace_fd) : m_saved_fd{enter_namespace(namespace_fd)} {}
+
+NetNamespaceGuard::NetNamespaceGuard(std::string const &name) : m_saved_fd{enter_named_namespace(name)} {}
+
+NetNamespaceGuard::~NetNamespaceGuard() {
+    // Возврат в сохранённое пространство имен по открытому дескриптору не может завершиться ошибкой
+    // при корректном дескрипторе, а исключение из деструктора недопустимо.
+    ::setns(m_saved_fd, CLONE_NEWNET);
+    ::close(m_saved_fd);
+}
+
+} // namespace os::network
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+
+namespace os::network {
+
+/**
+ * @class NetNamespaceGuard
+ * @brief Переключает вызывающий поток в сетевое пространство имен и возвращает его обратно при разрушении
+ *
+ * setns(CLONE_NEWNET) действует только на вызывающий поток, поэтому несколько потоков могут
+ * одновременно работать в разных пространствах имен.
+ */
+class NetNamespaceGuard final {
+   public:
+    /**
+     * @brief Переключает поток в пространство имен, заданное дескриптором
+     * @param namespace_fd Дескриптор пространства имен (владение не передаётся)
+     * @throw exceptions::OpenNamespace если не удалось сохранить текущее пространство имен
+     * @throw exceptions::SwitchNamespace если не удалось переключиться
+     */
+    explicit NetNamespaceGuard(int namespace_fd);
+    /**
+     * @brief Переключает поток в именованное пространство имен из /var/run/netns
+     * @param name Имя пространства имен
+     * @throw exceptions::OpenNamespace если пространство имен не найдено
+     * @throw exceptions::SwitchNamespace если не удалось переключиться
+     */
+    explicit NetNamespaceGuard(std::string const &name);
+    ~NetNamespaceGuard();
+
+    NetNamespaceGuard(NetNamespaceGuard const &) = delete;
+    NetNamespaceGuard(NetNamespaceGuard &&) = delete;
+    NetNamespaceGuard &operator=(NetNamespaceGuard const &) = delete;
+    NetNamespaceGuard &operator=(NetNamespaceGuard &&) = delete;
+
+   private:
+    int m_saved_fd{-1}; /**< Дескриптор исходного пространства имен потока */
+};
+
+} // namespace os::network
@@ -0,0 +1,64 @@
+#include "neighbour_lookup.hpp"
+
+#include <netlink/addr.h>
+#include <netlink/object.h>
+#include <sys/socket.h>
+
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace os::network {
+
+bool NeighbourLookupTable::Key::operator==(Key const &other) const noexcept {
+    return std::memcmp(this, &other, sizeof(Key)) == 0;
+}
+std::size_t NeighbourLookupTable::KeyHash::operator()(Key const &key) const noexcept {
+    return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<char const *>(&key), sizeof(key)));
+}
+bool NeighbourLookupTable::make_key(rtnl_neigh *neigh, Key &key) {
+    nl_addr *const dst = rtnl_neigh_get_dst(neigh);
+    if (dst == nullptr) {
+        return false;
+    }
+
+    int const family = nl_addr_get_family(dst);
+    std::size_t const length = family == AF_INET ? 4 : 16;
+    if ((family != AF_INET && family != AF_INET6) || nl_addr_get_len(dst) != length) {
+        return false;
+    }
+
+    key.ifindex = rtnl_neigh_get_ifindex(neigh);
+    key.family = family;
+    std::memcpy(key.address, nl_addr_get_binary_addr(dst), length);
+    return true;
+}
+void NeighbourLookupTable::add(rtnl_neigh *neigh) {
+    Key key{};
+    if (!make_key(neigh, key)) {
+        return;
+    }
+
+    nl_object_get(OBJ_CAST(neigh));
+    m_entries.insert_or_assign(key, NeighPtr{neigh, rtnl_neigh_put});
+}
+void NeighbourLookupTable::remove(rtnl_neigh *neigh) {
+    Key key{};
+    if (make_key(neigh, key)) {
+        m_entries.erase(key);
+    }
+}
+void NeighbourLookupTable::clear() {
+    m_entries.clear();
+}
+rtnl_neigh *NeighbourLookupTable::lookup(int const ifindex, int const family, void const *address) const {
+    Key key{};
+    key.ifindex = ifindex;
+    key.family = family;
+    std::memcpy(key.address, address, family == AF_INET ? 4 : 16);
+
+    auto const entry = m_entries.find(key);
+    return entry == m_entries.end() ? nullptr : entry->second.get();
+}
+
+} // namespace os::network
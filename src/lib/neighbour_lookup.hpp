@@ -0,0 +1,82 @@
+#pragma once
+
+#include <netlink/route/neighbour.h>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+namespace os::network {
+
+/**
+ * @class NeighbourLookupTable
+ * @brief Хеш-индекс записей ARP/NDP по паре (индекс интерфейса, IP-адрес)
+ *
+ * Индекс удерживает ссылки на объекты соседей, поэтому найденная запись остаётся действительной
+ * до её удаления из индекса. Записи без адреса назначения и не-IP записи не индексируются.
+ */
+class NeighbourLookupTable final {
+   public:
+    using NeighPtr = std::unique_ptr<rtnl_neigh, decltype(&rtnl_neigh_put)>;
+
+    /**
+     * @brief Добавляет запись или заменяет запись с тем же ключом
+     * @param neigh Запись; индекс берёт собственную ссылку
+     */
+    void add(rtnl_neigh *neigh);
+    /**
+     * @brief Удаляет запись с тем же интерфейсом и адресом
+     * @param neigh Запись или её копия
+     */
+    void remove(rtnl_neigh *neigh);
+    /**
+     * @brief Удаляет все записи
+     */
+    void clear();
+    /**
+     * @brief Находит запись по интерфейсу и адресу
+     * @param ifindex Индекс интерфейса
+     * @param family AF_INET или AF_INET6
+     * @param address Адрес в сетевом порядке байт (4 или 16 байт)
+     * @return Запись или nullptr
+     */
+    [[nodiscard]] rtnl_neigh *lookup(int ifindex, int family, void const *address) const;
+    /**
+     * @brief Возвращает количество записей в индексе
+     * @return Количество записей
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+
+   private:
+    /**
+     * @struct Key
+     * @brief Ключ записи (без выравнивающих байтов, поэтому хешируется как массив байт)
+     */
+    struct Key {
+        int ifindex{};               /**< Индекс интерфейса */
+        int family{};                /**< Семейство адреса */
+        unsigned char address[16]{}; /**< Адрес, дополненный нулями до 16 байт */
+
+        bool operator==(Key const &other) const noexcept;
+    };
+
+    /**
+     * @struct KeyHash
+     * @brief Хеш ключа записи
+     */
+    struct KeyHash {
+        std::size_t operator()(Key const &key) const noexcept;
+    };
+
+    /**
+     * @brief Строит ключ записи
+     * @param neigh Запись
+     * @param key Ключ
+     * @return false, если запись не индексируется
+     */
+    static bool make_key(rtnl_neigh *neigh, Key &key);
+
+    std::unordered_map<Key, NeighPtr, KeyHash> m_entries{}; /**< Записи по ключу */
+};
+
+} // namespace os::network
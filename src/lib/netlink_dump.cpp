@@ -0,0 +1,134 @@
+#include "informer/netlink_dump.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <linux/rtnetlink.h>
+#include <netlink/msg.h>
+#include <netlink/netlink.h>
+#include <netlink/route/rtnl.h>
+#include <netlink/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+
+#include "namespace_guard.hpp"
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @brief Дописывает принятое сообщение дампа в буфер записи
+ * @param msg Сообщение Netlink
+ * @param data Указатель на std::string с содержимым файла
+ * @return NL_OK
+ */
+int append_message(nl_msg *msg, void *data) {
+    auto *const out = static_cast<std::string *>(data);
+    nlmsghdr const *const header = nlmsg_hdr(msg);
+    out->append(reinterpret_cast<char const *>(header), header->nlmsg_len);
+    out->resize(out->size() + (NLMSG_ALIGN(header->nlmsg_len) - header->nlmsg_len), '\0');
+    return NL_OK;
+}
+
+/**
+ * @brief Выполняет дамп кэшей через сокет, открытый в текущем пространстве имен потока
+ * @param caches Маска кэшей
+ * @return Содержимое файла дампа вместе с заголовком
+ * @throw exceptions::NetlinkDumpEx если не удалось выполнить дамп
+ */
+std::string dump_caches(Cache const caches) {
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> const socket{nl_socket_alloc(), nl_socket_free};
+    if (!socket) {
+        throw exceptions::NetlinkDumpEx("Allocate netlink socket");
+    }
+    if (int const ret = nl_connect(socket.get(), NETLINK_ROUTE); ret < 0) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("Connect to NETLINK_ROUTE: {}", nl_geterror(ret)));
+    }
+    // Таблица маршрутов на сотни тысяч записей приходит быстрее, чем разбирается.
+    nl_socket_set_buffer_size(socket.get(), 4 * 1024 * 1024, 0);
+
+    NetlinkDumpHeader const header{.caches = static_cast<uint32_t>(caches & Cache::All)};
+    std::string out(reinterpret_cast<char const *>(&header), sizeof(header));
+    if (int const ret = nl_socket_modify_cb(socket.get(), NL_CB_VALID, NL_CB_CUSTOM, append_message, &out); ret < 0) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("Set netlink callback: {}", nl_geterror(ret)));
+    }
+
+    struct Request {
+        Cache kind;
+        int type;
+        char const *name;
+    };
+    constexpr Request requests[] = {
+        {Cache::Link, RTM_GETLINK, "links"},
+        {Cache::Addr, RTM_GETADDR, "addresses"},
+        {Cache::Route, RTM_GETROUTE, "routes"},
+        {Cache::Neigh, RTM_GETNEIGH, "neighbours"},
+    };
+    for (auto const &request : requests) {
+        if ((caches & request.kind) == Cache::None) {
+            continue;
+        }
+        if (int const ret = nl_rtgen_request(socket.get(), request.type, AF_UNSPEC, NLM_F_DUMP); ret < 0) {
+            throw exceptions::NetlinkDumpEx(::fmt::format("Request {} dump: {}", request.name, nl_geterror(ret)));
+        }
+        if (int const ret = nl_recvmsgs_default(socket.get()); ret < 0) {
+            throw exceptions::NetlinkDumpEx(::fmt::format("Receive {} dump: {}", request.name, nl_geterror(ret)));
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Записывает содержимое в файл через временное имя
+ * @param path Путь к файлу
+ * @param content Содержимое
+ * @throw exceptions::NetlinkDumpEx если не удалось записать файл
+ */
+void write_file(std::string const &path, std::string const &content) {
+    std::string const temporary = path + ".tmp";
+    int const fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw exceptions::NetlinkDumpEx(::fmt::format("Create {}: {}", temporary, std::strerror(errno)));
+    }
+
+    std::size_t offset = 0;
+    while (offset < content.size()) {
+        ssize_t const written = ::write(fd, content.data() + offset, content.size() - offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0) {
+            int const error = errno;
+            ::close(fd);
+            ::unlink(temporary.c_str());
+            throw exceptions::NetlinkDumpEx(::fmt::format("Write {}: {}", temporary, std::strerror(error)));
+        }
+        offset += static_cast<std::size_t>(written);
+    }
+
+    if (::close(fd) != 0 || ::rename(temporary.c_str(), path.c_str()) != 0) {
+        int const error = errno;
+        ::unlink(temporary.c_str());
+        throw exceptions::NetlinkDumpEx(::fmt::format("Save {}: {}", path, std::strerror(error)));
+    }
+}
+
+} // namespace
+
+void record_netlink_dump(std::string const &path, Cache const caches) {
+    write_file(path, dump_caches(caches));
+}
+
+void record_netlink_dump(std::string const &path, int const namespace_fd, Cache const caches) {
+    std::string content;
+    {
+        // Поток возвращается в исходное пространство имен сразу после дампа, до записи файла.
+        NetNamespaceGuard const guard(namespace_fd);
+        content = dump_caches(caches);
+    }
+    write_file(path, content);
+}
+
+} // namespace os::network
@@ -0,0 +1,473 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace os::network {
+
+/**
+ * @brief 128-битный ключ IPv6 (старший бит - первый бит адреса)
+ */
+using Ipv6Key = unsigned __int128;
+
+/**
+ * @class PrefixTrie
+ * @brief Сжатое двоичное дерево префиксов (Patricia) для поиска по наибольшему совпадению
+ *
+ * Узлы хранятся в непрерывном массиве и ссылаются друг на друга индексами, поэтому дерево на
+ * миллион префиксов занимает десятки мегабайт и не фрагментирует кучу. Каждый узел хранит
+ * префикс целиком, цепочки узлов с единственным потомком не создаются: глубина поиска ограничена
+ * количеством точек ветвления на пути. Значения хранятся отдельно от узлов, чтобы узлы оставались
+ * компактными.
+ *
+ * Когда префиксов становится не меньше M_JUMP_THRESHOLD, дерево дополняется таблицей переходов
+ * по первым M_JUMP_BITS битам адреса: поиск начинается сразу с узла, до которого дошёл бы обход
+ * верхних уровней. При изменении дерева пересчитываются только записи, обход которых проходит
+ * через изменённую связь или значение.
+ * @tparam Key Беззнаковый тип ключа (uint32_t для IPv4, Ipv6Key для IPv6)
+ * @tparam Value Тип значения префикса
+ */
+template <typename Key, typename Value>
+class PrefixTrie final {
+   public:
+    /**
+     * @brief Разрядность ключа
+     */
+    static constexpr unsigned M_BITS = sizeof(Key) * 8;
+    /**
+     * @brief Количество бит адреса, по которым индексируется таблица переходов
+     */
+    static constexpr unsigned M_JUMP_BITS = M_BITS < 16 ? M_BITS : 16;
+    /**
+     * @brief Количество префиксов, начиная с которого строится таблица переходов
+     */
+    static constexpr std::size_t M_JUMP_THRESHOLD = 4096;
+
+    /**
+     * @brief Возвращает значение префикса, создавая его при отсутствии
+     * @param key Ключ (биты за пределами length игнорируются)
+     * @param length Длина префикса (0..M_BITS)
+     * @return Ссылка на значение (действительна до следующего изменения дерева)
+     */
+    Value &insert(Key const key, unsigned const length) {
+        Value &value = insert_node(key & mask(length), length);
+        if (m_jumps.empty() && m_size >= M_JUMP_THRESHOLD) {
+            m_jumps.resize(std::size_t{1} << M_JUMP_BITS);
+            touch(0, 0);
+        }
+        refresh_jumps();
+        return value;
+    }
+
+    /**
+     * @brief Находит значение префикса с точным совпадением длины
+     * @param key Ключ
+     * @param length Длина префикса
+     * @return Указатель на значение или nullptr
+     */
+    Value *find(Key key, unsigned const length) {
+        key &= mask(length);
+        uint32_t index = m_root;
+        while (index != M_NIL) {
+            Node const &node = m_nodes[index];
+            if (node.length > length || ((key ^ node.key) & mask(node.length)) != 0) {
+                return nullptr;
+            }
+            if (node.length == length) {
+                return node.value == M_NIL ? nullptr : &m_values[node.value];
+            }
+            index = node.child[bit(key, node.length)];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Удаляет префикс и освобождает узлы, ставшие лишними
+     * @param key Ключ
+     * @param length Длина префикса
+     * @return true, если префикс был в дереве
+     */
+    bool erase(Key key, unsigned const length) {
+        key &= mask(length);
+
+        // Путь от корня нужен для удаления узлов ветвления, у которых остался один потомок.
+        uint32_t path[M_BITS + 1];
+        unsigned depth = 0;
+        uint32_t index = m_root;
+        while (index != M_NIL) {
+            Node const &node = m_nodes[index];
+            if (node.length > length || ((key ^ node.key) & mask(node.length)) != 0) {
+                return false;
+            }
+            path[depth++] = index;
+            if (node.length == length) {
+                break;
+            }
+            index = node.child[bit(key, node.length)];
+        }
+        if (index == M_NIL || m_nodes[index].value == M_NIL) {
+            return false;
+        }
+
+        Node &target = m_nodes[index];
+        m_values[target.value] = Value{};
+        m_free_values.push_back(target.value);
+        target.value = M_NIL;
+        touch(target.key, target.length);
+        --m_size;
+
+        // Узел без значения нужен, только если у него два потомка.
+        while (depth > 0) {
+            uint32_t const current = path[--depth];
+            Node const &node = m_nodes[current];
+            if (node.value != M_NIL || (node.child[0] != M_NIL && node.child[1] != M_NIL)) {
+                break;
+            }
+            uint32_t const child = node.child[0] != M_NIL ? node.child[0] : node.child[1];
+            uint32_t const parent = depth > 0 ? path[depth - 1] : M_NIL;
+            link(parent, parent == M_NIL ? 0 : bit(node.key, m_nodes[parent].length), child);
+            release_node(current);
+            if (child != M_NIL) {
+                break;
+            }
+        }
+
+        refresh_jumps();
+        return true;
+    }
+
+    /**
+     * @brief Находит значение наиболее длинного префикса, покрывающего адрес
+     * @param address Адрес
+     * @return Указатель на значение или nullptr, если ни один префикс не покрывает адрес
+     */
+    [[nodiscard]] Value const *match(Key const address) const {
+        uint32_t best = M_NIL;
+        uint32_t index = m_root;
+        if (!m_jumps.empty()) {
+            Jump const &jump = m_jumps[slot(address)];
+            best = jump.value;
+            index = jump.node;
+        }
+
+        while (index != M_NIL) {
+            Node const &node = m_nodes[index];
+            if (((address ^ node.key) & mask(node.length)) != 0) {
+                break;
+            }
+            if (node.value != M_NIL) {
+                best = node.value;
+            }
+            if (node.length == M_BITS) {
+                break;
+            }
+            index = node.child[bit(address, node.length)];
+        }
+        return best == M_NIL ? nullptr : &m_values[best];
+    }
+
+    /**
+     * @brief Удаляет все префиксы
+     */
+    void clear() {
+        m_nodes.clear();
+        m_free_nodes.clear();
+        m_values.clear();
+        m_free_values.clear();
+        m_jumps.clear();
+        m_root = M_NIL;
+        m_size = 0;
+        m_dirty = false;
+    }
+
+    /**
+     * @brief Возвращает количество префиксов
+     * @return Количество префиксов со значением
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+   private:
+    /**
+     * @brief Признак отсутствия узла или значения
+     */
+    static constexpr uint32_t M_NIL = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @struct Node
+     * @brief Узел дерева
+     */
+    struct Node {
+        Key key{};                       /**< Префикс (биты за пределами length равны нулю) */
+        uint32_t child[2]{M_NIL, M_NIL}; /**< Потомки по биту с номером length */
+        uint32_t value{M_NIL};           /**< Индекс значения или M_NIL для узла ветвления */
+        uint8_t length{};                /**< Длина префикса */
+    };
+
+    /**
+     * @struct Jump
+     * @brief Запись таблицы переходов: результат обхода узлов короче M_JUMP_BITS
+     */
+    struct Jump {
+        uint32_t node{M_NIL};  /**< Первый узел длиной не меньше M_JUMP_BITS на пути или M_NIL */
+        uint32_t value{M_NIL}; /**< Значение наиболее длинного из пройденных префиксов или M_NIL */
+    };
+
+    /**
+     * @brief Маска первых length бит
+     * @param length Количество бит
+     * @return Маска
+     */
+    static constexpr Key mask(unsigned const length) { return length == 0 ? Key{0} : static_cast<Key>(~Key{0} << (M_BITS - length)); }
+    /**
+     * @brief Бит ключа с номером position (0 - старший)
+     * @param key Ключ
+     * @param position Номер бита
+     * @return 0 или 1
+     */
+    static constexpr unsigned bit(Key const key, unsigned const position) { return static_cast<unsigned>((key >> (M_BITS - 1 - position)) & 1u); }
+    /**
+     * @brief Длина общего префикса двух ключей
+     * @param lhs Первый ключ
+     * @param rhs Второй ключ
+     * @param limit Максимальная длина
+     * @return Количество совпадающих старших бит (не более limit)
+     */
+    static unsigned common_length(Key const lhs, Key const rhs, unsigned const limit) {
+        Key const difference = lhs ^ rhs;
+        if (difference == 0) {
+            return limit;
+        }
+        unsigned zeros = 0;
+        if constexpr (M_BITS == 128) {
+            auto const high = static_cast<uint64_t>(difference >> 64);
+            zeros = high != 0 ? __builtin_clzll(high) : 64 + __builtin_clzll(static_cast<uint64_t>(difference));
+        } else if constexpr (M_BITS == 64) {
+            zeros = __builtin_clzll(difference);
+        } else {
+            zeros = __builtin_clz(difference);
+        }
+        return zeros < limit ? zeros : limit;
+    }
+
+    /**
+     * @brief Вставляет префикс в дерево без пересчёта таблицы переходов
+     * @param key Ключ с обнулёнными битами за пределами length
+     * @param length Длина префикса
+     * @return Ссылка на значение
+     */
+    Value &insert_node(Key const key, unsigned const length) {
+        uint32_t parent = M_NIL;
+        unsigned side = 0;
+        uint32_t index = m_root;
+        while (index != M_NIL) {
+            Key const node_key = m_nodes[index].key;
+            unsigned const node_length = m_nodes[index].length;
+            unsigned const common = common_length(key, node_key, length < node_length ? length : node_length);
+            if (common == node_length && common == length) {
+                return value_of(index);
+            }
+            if (common == node_length) {
+                parent = index;
+                side = bit(key, node_length);
+                index = m_nodes[index].child[side];
+                continue;
+            }
+
+            if (common == length) {
+                // Новый префикс короче и покрывает узел: вставляется над ним.
+                uint32_t const node = allocate_node(key, length);
+                m_nodes[node].child[bit(node_key, length)] = index;
+                link(parent, side, node);
+                return value_of(node);
+            }
+
+            // Префиксы расходятся: создаётся узел ветвления без значения.
+            uint32_t const branch = allocate_node(key & mask(common), common);
+            uint32_t const leaf = allocate_node(key, length);
+            m_nodes[branch].child[bit(key, common)] = leaf;
+            m_nodes[branch].child[bit(node_key, common)] = index;
+            link(parent, side, branch);
+            return value_of(leaf);
+        }
+
+        uint32_t const leaf = allocate_node(key, length);
+        link(parent, side, leaf);
+        return value_of(leaf);
+    }
+    /**
+     * @brief Создаёт узел без значения и потомков
+     * @param key Префикс
+     * @param length Длина префикса
+     * @return Индекс узла
+     */
+    uint32_t allocate_node(Key const key, unsigned const length) {
+        Node const node{key, {M_NIL, M_NIL}, M_NIL, static_cast<uint8_t>(length)};
+        if (!m_free_nodes.empty()) {
+            uint32_t const index = m_free_nodes.back();
+            m_free_nodes.pop_back();
+            m_nodes[index] = node;
+            return index;
+        }
+        m_nodes.push_back(node);
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+    /**
+     * @brief Возвращает узел в список свободных
+     * @param index Индекс узла
+     */
+    void release_node(uint32_t const index) {
+        m_nodes[index] = Node{};
+        m_free_nodes.push_back(index);
+    }
+    /**
+     * @brief Возвращает значение узла, назначая его при отсутствии
+     * @param index Индекс узла
+     * @return Ссылка на значение
+     */
+    Value &value_of(uint32_t const index) {
+        Node &node = m_nodes[index];
+        if (node.value == M_NIL) {
+            if (!m_free_values.empty()) {
+                node.value = m_free_values.back();
+                m_free_values.pop_back();
+            } else {
+                m_values.emplace_back();
+                node.value = static_cast<uint32_t>(m_values.size() - 1);
+            }
+            touch(node.key, node.length);
+            ++m_size;
+        }
+        return m_values[node.value];
+    }
+    /**
+     * @brief Подвешивает узел к родителю (или делает корнем)
+     * @param parent Индекс родителя или M_NIL
+     * @param side Сторона потомка у родителя
+     * @param index Индекс узла (M_NIL - отцепить)
+     */
+    void link(uint32_t const parent, unsigned const side, uint32_t const index) {
+        if (parent == M_NIL) {
+            m_root = index;
+            touch(0, 0);
+            return;
+        }
+        Node &node = m_nodes[parent];
+        node.child[side] = index;
+        if (node.length < M_BITS) {
+            touch(node.key | static_cast<Key>(Key{side} << (M_BITS - 1 - node.length)), node.length + 1);
+        }
+    }
+
+    /**
+     * @brief Отмечает записи таблицы переходов, покрытые префиксом, для пересчёта
+     *
+     * Записи зависят только от узлов короче M_JUMP_BITS, поэтому более глубокие изменения не отмечаются.
+     * Отметки одного изменения объединяются в их общий префикс.
+     * @param key Префикс
+     * @param length Длина префикса
+     */
+    void touch(Key const key, unsigned const length) {
+        if (m_jumps.empty() || length > M_JUMP_BITS) {
+            return;
+        }
+        if (!m_dirty) {
+            m_dirty = true;
+            m_dirty_key = key;
+            m_dirty_length = length;
+            return;
+        }
+        m_dirty_length = common_length(key, m_dirty_key, length < m_dirty_length ? length : m_dirty_length);
+        m_dirty_key &= mask(m_dirty_length);
+    }
+    /**
+     * @brief Пересчитывает отмеченные записи таблицы переходов
+     */
+    void refresh_jumps() {
+        if (!m_dirty) {
+            return;
+        }
+        m_dirty = false;
+        fill_jumps(m_root, m_dirty_key & mask(m_dirty_length), m_dirty_length, M_NIL);
+    }
+    /**
+     * @brief Заполняет записи таблицы переходов, покрытые префиксом, обходом поддерева
+     *
+     * Каждая запись и каждый узел короче M_JUMP_BITS посещаются один раз, поэтому пересчёт всей
+     * таблицы (например, при изменении маршрута по умолчанию) стоит порядка 2^M_JUMP_BITS шагов.
+     * @param index Узел, с которого продолжается обход для адресов префикса
+     * @param key Префикс
+     * @param length Длина префикса (не больше M_JUMP_BITS)
+     * @param best Значение наиболее длинного префикса, пройденного до узла index
+     */
+    void fill_jumps(uint32_t index, Key key, unsigned length, uint32_t best) {
+        while (true) {
+            if (index == M_NIL || m_nodes[index].length >= M_JUMP_BITS) {
+                assign_jumps(key, length, Jump{index, best});
+                return;
+            }
+
+            Node const &node = m_nodes[index];
+            unsigned const limit = length < node.length ? length : node.length;
+            if (common_length(key, node.key, limit) < limit) {
+                assign_jumps(key, length, Jump{M_NIL, best});
+                return;
+            }
+            if (node.length > length) {
+                // Адреса префикса вне поддерева узла с ним не совпадают.
+                std::size_t const first = slot(key);
+                std::size_t const last = first + (std::size_t{1} << (M_JUMP_BITS - length));
+                std::size_t const inner_first = slot(node.key);
+                std::size_t const inner_last = inner_first + (std::size_t{1} << (M_JUMP_BITS - node.length));
+                std::fill(m_jumps.begin() + first, m_jumps.begin() + inner_first, Jump{M_NIL, best});
+                std::fill(m_jumps.begin() + inner_last, m_jumps.begin() + last, Jump{M_NIL, best});
+                key = node.key;
+                length = node.length;
+            }
+
+            if (node.value != M_NIL) {
+                best = node.value;
+            }
+            if (node.length < length) {
+                index = node.child[bit(key, node.length)];
+                continue;
+            }
+
+            // Префикс совпал с узлом: левое поддерево обходится рекурсивно, правое - в этом же цикле.
+            fill_jumps(node.child[0], key, length + 1, best);
+            index = node.child[1];
+            key |= static_cast<Key>(Key{1} << (M_BITS - 1 - length));
+            length += 1;
+        }
+    }
+    /**
+     * @brief Назначает одну запись всем адресам префикса
+     * @param key Префикс
+     * @param length Длина префикса (не больше M_JUMP_BITS)
+     * @param jump Запись
+     */
+    void assign_jumps(Key const key, unsigned const length, Jump const jump) {
+        auto const first = m_jumps.begin() + static_cast<std::ptrdiff_t>(slot(key));
+        std::fill(first, first + (std::ptrdiff_t{1} << (M_JUMP_BITS - length)), jump);
+    }
+    /**
+     * @brief Номер записи таблицы переходов для адреса
+     * @param address Адрес
+     * @return Значение первых M_JUMP_BITS бит адреса
+     */
+    static std::size_t slot(Key const address) { return static_cast<std::size_t>(address >> (M_BITS - M_JUMP_BITS)); }
+
+    std::vector<Node> m_nodes{};           /**< Узлы */
+    std::vector<uint32_t> m_free_nodes{};  /**< Освобождённые узлы */
+    std::vector<Value> m_values{};         /**< Значения префиксов */
+    std::vector<uint32_t> m_free_values{}; /**< Освобождённые значения */
+    std::vector<Jump> m_jumps{};           /**< Таблица переходов (пуста до M_JUMP_THRESHOLD префиксов) */
+    uint32_t m_root{M_NIL};                /**< Корень */
+    std::size_t m_size{};                  /**< Количество префиксов */
+    Key m_dirty_key{};                     /**< Общий префикс записей, ожидающих пересчёта */
+    unsigned m_dirty_length{};             /**< Длина m_dirty_key */
+    bool m_dirty{false};                   /**< Есть записи, ожидающие пересчёта */
+};
+
+} // namespace os::network
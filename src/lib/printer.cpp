@@ -5,124 +5,1114 @@
 #include <fcntl.h>
 #include <fmt/format.h>
 #include <linux/if_arp.h>
+#include <linux/neighbour.h>
 #include <netlink/route/neighbour.h>
 #include <netlink/route/route.h>
-
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 
+#include "data_source.hpp"
+#include "namespace_guard.hpp"
+
 namespace os::network {
 
-InformerNetlink *InformerNetlink::create(char *error_message) noexcept {
+InformerNetlink *InformerNetlink::create(InformerOptions const &options, char *error_message) noexcept {
     try {
-        auto *new_object = new ShowInfoInterface();
+        auto *new_object = new ShowInfoInterface(options, std::make_unique<NetlinkDataSource>());
         return new_object;
     } catch (std::exception const &ex) {
         ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
         return nullptr;
     }
 }
+InformerNetlink *InformerNetlink::create_in_namespace(std::string const &name, InformerOptions const &options, char *error_message) noexcept {
+    try {
+        // Сокеты Netlink (включая сокеты менеджера кэшей) открываются в конструкторе и остаются
+        // привязанными к пространству имен после возврата потока обратно.
+        NetNamespaceGuard const guard(name);
+        auto *new_object = new ShowInfoInterface(options, std::make_unique<NetlinkDataSource>());
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object in namespace %s: %s", name.c_str(), ex.what());
+        return nullptr;
+    }
+}
+InformerNetlink *InformerNetlink::create_in_namespace(int const namespace_fd, InformerOptions const &options, char *error_message) noexcept {
+    try {
+        NetNamespaceGuard const guard(namespace_fd);
+        auto *new_object = new ShowInfoInterface(options, std::make_unique<NetlinkDataSource>());
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object in namespace fd %d: %s", namespace_fd, ex.what());
+        return nullptr;
+    }
+}
+InformerNetlink *InformerNetlink::create_from_dump(std::string const &path, InformerOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new ShowInfoInterface(options, std::make_unique<ReplayDataSource>(path));
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object from dump %s: %s", path.c_str(), ex.what());
+        return nullptr;
+    }
+}
 
-ShowInfoInterface::ShowInfoInterface()
-    : m_netlink_socket{nl_socket_alloc(), nl_socket_free},
+ShowInfoInterface::ShowInfoInterface(InformerOptions const &options, std::unique_ptr<DataSource> data_source)
+    : m_update_mode{options.update_mode},
+      m_scope{options.scope},
+      m_data_source{std::move(data_source)},
       m_link_data{nullptr, nl_cache_free},
       m_addr_data{nullptr, nl_cache_free},
       m_route_data{nullptr, nl_cache_free},
       m_neigh_data{nullptr, nl_cache_free} {
-    if (!m_netlink_socket) {
-        throw exceptions::AllocateSocket("Allocate netlink socket");
+    if (m_update_mode == UpdateMode::Events) {
+        if (m_data_source->control_socket() == nullptr) {
+            throw exceptions::CacheManager("Режим UpdateMode::Events недоступен для источника без подключения к ядру");
+        }
+        // Менеджер выполняет начальный дамп и применяет уведомления без учёта условий.
+        if (!m_scope.empty()) {
+            throw exceptions::CacheManager("Ограничение дампа недоступно в режиме UpdateMode::Events");
+        }
+        // Менеджер использует собственные сокеты: один подписан на группы RTNLGRP_*, второй служит для начального дампа.
+        // NL_AUTO_PROVIDE не используется, так как он регистрирует кэши глобально для всего процесса.
+        nl_cache_mngr *tmp_manager = nullptr;
+        if (int const ret = nl_cache_mngr_alloc(nullptr, NETLINK_ROUTE, 0, &tmp_manager); ret < 0) {
+            throw exceptions::CacheManager(::fmt::format("Allocate cache manager: {}", nl_geterror(ret)));
+        }
+        m_cache_manager.reset(tmp_manager);
+        // Переполнение буфера (ENOBUFS) libnl сообщает как "Out of memory", и уведомления теряются.
+        int const buffer_size = M_EVENT_BUFFER_BYTES;
+        ::setsockopt(nl_cache_mngr_get_fd(tmp_manager), SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    }
+    // Буфер приёма рассчитывается на подтверждения целой пачки set_interfaces_state.
+    if (nl_sock *const socket = m_data_source->control_socket()) {
+        nl_socket_set_buffer_size(socket, static_cast<int>(M_CHANGE_BATCH_SIZE) * M_ACK_BUFFER_BYTES, 0);
     }
 
-    if (nl_connect(m_netlink_socket.get(), NETLINK_ROUTE) < 0) {
-        throw exceptions::ConnectNetlinkRoute("Connect to NETLINK_ROUTE");
+    load_caches(options.preload);
+}
+void ShowInfoInterface::load_caches(Cache const caches) {
+    for (auto const kind : {Cache::Link, Cache::Addr, Cache::Route, Cache::Neigh}) {
+        if ((caches & kind) != Cache::None) {
+            load_cache(kind);
+        }
+    }
+}
+std::unique_ptr<nl_cache, decltype(&nl_cache_free)> &ShowInfoInterface::cache_slot(Cache const kind) {
+    switch (kind) {
+        case Cache::Link:
+            return m_link_data;
+        case Cache::Addr:
+            return m_addr_data;
+        case Cache::Route:
+            return m_route_data;
+        default:
+            return m_neigh_data;
+    }
+}
+void ShowInfoInterface::mark_index_dirty(Cache const kind) {
+    switch (kind) {
+        case Cache::Link:
+            m_link_index_dirty = true;
+            break;
+        case Cache::Addr:
+            m_addr_index_dirty = true;
+            break;
+        case Cache::Route:
+            m_route_index_dirty = true;
+            break;
+        default:
+            m_neigh_index_dirty = true;
+    }
+}
+void ShowInfoInterface::load_cache(Cache const kind) {
+    auto &slot = cache_slot(kind);
+    mark_index_dirty(kind);
+    if (kind == Cache::Route) {
+        // Индекс по префиксу, в отличие от группировок, обновляется по уведомлениям и перестраивается только после дампа.
+        m_route_lookup_dirty = true;
+    } else if (kind == Cache::Neigh) {
+        m_neigh_lookup_dirty = true;
     }
 
-    auto tmp_link_data = m_link_data.release();
-    if (rtnl_link_alloc_cache(m_netlink_socket.get(), AF_UNSPEC, &tmp_link_data) < 0) {
-        throw exceptions::GetDataLinks("Allocate link cache");
+    DumpFilter const filter = dump_filter(kind);
+    if (slot) {
+        if (int const ret = m_data_source->fill(kind, slot.get(), filter); ret < 0) {
+            throw exceptions::InterfaceOperationEx(::fmt::format("Не удалось перезагрузить кэш: {}", nl_geterror(ret)));
+        }
+        discard_out_of_scope(kind, slot.get(), filter);
+        return;
     }
-    m_link_data.reset(tmp_link_data);
 
-    auto tmp_addr_data = m_addr_data.release();
-    if (rtnl_addr_alloc_cache(m_netlink_socket.get(), &tmp_addr_data) < 0) {
-        throw exceptions::GetDataAddr("Allocate address cache");
+    // Кэш создаётся пустым и заполняется источником данных, а в режиме UpdateMode::Events - менеджером
+    // при добавлении, чтобы не делать дамп дважды.
+    nl_cache *tmp_data = nullptr;
+    switch (kind) {
+        case Cache::Link:
+            if (rtnl_link_alloc_cache(nullptr, AF_UNSPEC, &tmp_data) < 0) {
+                throw exceptions::GetDataLinks("Allocate link cache");
+            }
+            break;
+        case Cache::Addr:
+            if (rtnl_addr_alloc_cache(nullptr, &tmp_data) < 0) {
+                throw exceptions::GetDataAddr("Allocate address cache");
+            }
+            break;
+        case Cache::Route:
+            if (rtnl_route_alloc_cache(nullptr, AF_UNSPEC, 0, &tmp_data) < 0) {
+                throw exceptions::GetDataRoute("Allocate route cache");
+            }
+            break;
+        default:
+            if (rtnl_neigh_alloc_cache(nullptr, &tmp_data) < 0) {
+                throw exceptions::GetDataNeigh("Allocate neighbour cache");
+            }
+    }
+    std::unique_ptr<nl_cache, decltype(&nl_cache_free)> data{tmp_data, nl_cache_free};
+
+    if (!m_cache_manager) {
+        if (int const ret = m_data_source->fill(kind, data.get(), filter); ret < 0) {
+            switch (kind) {
+                case Cache::Link:
+                    throw exceptions::GetDataLinks(::fmt::format("Fill link cache: {}", nl_geterror(ret)));
+                case Cache::Addr:
+                    throw exceptions::GetDataAddr(::fmt::format("Fill address cache: {}", nl_geterror(ret)));
+                case Cache::Route:
+                    throw exceptions::GetDataRoute(::fmt::format("Fill route cache: {}", nl_geterror(ret)));
+                default:
+                    throw exceptions::GetDataNeigh(::fmt::format("Fill neighbour cache: {}", nl_geterror(ret)));
+            }
+        }
+        discard_out_of_scope(kind, data.get(), filter);
+        slot = std::move(data);
+        return;
     }
-    m_addr_data.reset(tmp_addr_data);
 
-    auto tmp_route_data = m_route_data.release();
-    if (rtnl_route_alloc_cache(m_netlink_socket.get(), AF_UNSPEC, 0, &tmp_route_data) < 0) {
-        throw exceptions::GetDataRoute("Allocate route cache");
+    slot = std::move(data);
+    // Менеджер освобождает добавленные кэши сам, поэтому берётся дополнительная ссылка.
+    nl_cache_get(slot.get());
+    if (int const ret = nl_cache_mngr_add_cache_v2(m_cache_manager.get(), slot.get(), on_cache_change, this); ret < 0) {
+        nl_cache_put(slot.get());
+        slot.reset();
+        throw exceptions::CacheManager(::fmt::format("Subscribe cache: {}", nl_geterror(ret)));
+    }
+}
+DumpFilter ShowInfoInterface::dump_filter(Cache const kind) {
+    DumpFilter filter;
+    if ((kind != Cache::Addr && kind != Cache::Route) || m_scope.empty()) {
+        return filter;
     }
-    m_route_data.reset(tmp_route_data);
 
-    auto tmp_neigh_data = m_neigh_data.release();
-    if (rtnl_neigh_alloc_cache(m_netlink_socket.get(), &tmp_neigh_data) < 0) {
-        throw exceptions::GetDataNeigh("Allocate neighbour cache");
+    filter.family = m_scope.family;
+    if (kind == Cache::Route) {
+        filter.table = m_scope.table;
+    }
+    if (!m_scope.interface.empty()) {
+        filter.ifindex = rtnl_link_get_ifindex(find_link(m_scope.interface));
     }
-    m_neigh_data.reset(tmp_neigh_data);
+    return filter;
 }
-void ShowInfoInterface::enable_interface(std::string const &interface_name) {
-    int const ifindex = getInterfaceIndex(interface_name);
+void ShowInfoInterface::discard_out_of_scope(Cache const kind, nl_cache *cache, DumpFilter const &filter) {
+    if (filter.empty()) {
+        return;
+    }
+
+    std::vector<nl_object *> rejected;
+    for (auto obj = nl_cache_get_first(cache); obj; obj = nl_cache_get_next(obj)) {
+        bool matches = true;
+        if (kind == Cache::Addr) {
+            auto *const addr = reinterpret_cast<struct rtnl_addr *>(obj);
+            matches = (filter.family == AF_UNSPEC || rtnl_addr_get_family(addr) == filter.family) &&
+                      (filter.ifindex == 0 || rtnl_addr_get_ifindex(addr) == filter.ifindex);
+        } else if (kind == Cache::Route) {
+            auto *const route = reinterpret_cast<struct rtnl_route *>(obj);
+            matches = (filter.family == AF_UNSPEC || rtnl_route_get_family(route) == filter.family) &&
+                      (filter.table == 0 || rtnl_route_get_table(route) == filter.table);
+            // Ядро отбирает маршруты, у которых через интерфейс проходит любой из nexthop.
+            bool uses_interface = filter.ifindex == 0;
+            for (int i = 0, count = rtnl_route_get_nnexthops(route); i < count && !uses_interface; i++) {
+                uses_interface = rtnl_route_nh_get_ifindex(rtnl_route_nexthop_n(route, i)) == filter.ifindex;
+            }
+            matches = matches && uses_interface;
+        }
+        if (!matches) {
+            rejected.push_back(obj);
+        }
+    }
+
+    for (nl_object *obj : rejected) {
+        nl_cache_remove(obj);
+    }
+}
+bool ShowInfoInterface::is_device_link(rtnl_link *link) {
+    return rtnl_link_get_num_tx_queues(link) != 0;
+}
+nl_sock *ShowInfoInterface::control_socket() const {
+    nl_sock *const socket = m_data_source->control_socket();
+    if (socket == nullptr) {
+        throw exceptions::InterfaceOperationEx("Изменение интерфейсов недоступно для экземпляра, созданного из записанного дампа");
+    }
+    return socket;
+}
+nl_cache *ShowInfoInterface::get_cache(Cache const kind) {
+    auto &slot = cache_slot(kind);
+    if (!slot) {
+        load_cache(kind);
+    }
+    return slot.get();
+}
+void ShowInfoInterface::on_cache_change(nl_cache *cache, nl_object *old_obj, nl_object *new_obj, uint64_t, int const action, void *data) {
+    auto *const self = static_cast<ShowInfoInterface *>(data);
+
+    Cache kind = Cache::Link;
+    if (cache == self->m_addr_data.get()) {
+        kind = Cache::Addr;
+    } else if (cache == self->m_route_data.get()) {
+        kind = Cache::Route;
+    } else if (cache == self->m_neigh_data.get()) {
+        kind = Cache::Neigh;
+    }
+
+    // Уведомления AF_INET6/AF_BRIDGE в кэше не хранятся: объект моста из такого уведомления имеет тот же
+    // идентификатор, что и полный объект, и заменил бы его, а обновление объектов порта моста менеджер
+    // завершает ошибкой. Заменённый полный объект возвращается в кэш.
+    if (kind == Cache::Link && new_obj && !is_device_link(reinterpret_cast<struct rtnl_link *>(new_obj))) {
+        if (nl_object_get_cache(new_obj) == cache) {
+            nl_cache_remove(new_obj);
+        }
+        if (old_obj && !nl_object_get_cache(old_obj) && is_device_link(reinterpret_cast<struct rtnl_link *>(old_obj))) {
+            nl_cache_add(cache, old_obj);
+        }
+        return;
+    }
+
+    self->mark_index_dirty(kind);
+    if (kind == Cache::Route && !self->m_route_lookup_dirty) {
+        auto *const route = reinterpret_cast<struct rtnl_route *>(new_obj ? new_obj : old_obj);
+        if (action == NL_ACT_DEL) {
+            self->m_route_lookup.remove(route);
+        } else {
+            if (old_obj) {
+                self->m_route_lookup.remove(reinterpret_cast<struct rtnl_route *>(old_obj));
+            }
+            self->m_route_lookup.add(route);
+        }
+    } else if (kind == Cache::Neigh && !self->m_neigh_lookup_dirty) {
+        auto *const neigh = reinterpret_cast<struct rtnl_neigh *>(new_obj ? new_obj : old_obj);
+        if (action == NL_ACT_DEL) {
+            self->m_neigh_lookup.remove(neigh);
+        } else {
+            self->m_neigh_lookup.add(neigh);
+        }
+    }
+    if (self->m_subscribed_events != Event::None) {
+        self->record_events(kind, old_obj, new_obj, action);
+    }
+    if (kind != Cache::Link) {
+        return;
+    }
+
+    // При выключении или удалении интерфейса ядро удаляет его IPv4-маршруты без уведомлений RTM_DELROUTE.
+    if (action == NL_ACT_DEL) {
+        self->m_routes_stale = true;
+    } else if (action == NL_ACT_CHANGE && old_obj && new_obj) {
+        bool const was_up = rtnl_link_get_flags(reinterpret_cast<struct rtnl_link *>(old_obj)) & IFF_UP;
+        bool const is_up = rtnl_link_get_flags(reinterpret_cast<struct rtnl_link *>(new_obj)) & IFF_UP;
+        if (was_up && !is_up) {
+            self->m_routes_stale = true;
+        }
+    }
+}
+void ShowInfoInterface::resync_stale_routes() {
+    if (!m_routes_stale) {
+        return;
+    }
+    m_routes_stale = false;
+
+    if (!m_route_data) {
+        return;
+    }
+    if ((m_subscribed_events & Event::RouteRemoved) == Event::None) {
+        load_cache(Cache::Route);
+        return;
+    }
+
+    // Перезагрузка не вызывает обработчик изменений, поэтому удалённые ядром маршруты находятся сравнением.
+    std::unique_ptr<nl_cache, decltype(&nl_cache_free)> const previous{nl_cache_clone(m_route_data.get()), nl_cache_free};
+    load_cache(Cache::Route);
+    if (!previous) {
+        return;
+    }
+    for (auto obj = nl_cache_get_first(previous.get()); obj; obj = nl_cache_get_next(obj)) {
+        if (nl_object *const same = nl_cache_search(m_route_data.get(), obj)) {
+            nl_object_put(same);
+        } else {
+            record_events(Cache::Route, obj, nullptr, NL_ACT_DEL);
+        }
+    }
+}
+int ShowInfoInterface::subscribe(Event const events, InterfaceEventCallback callback) {
+    if (!m_cache_manager) {
+        throw exceptions::InterfaceOperationEx("Подписка на события доступна только в режиме UpdateMode::Events");
+    }
+
+    get_cache(Cache::Link);
+    if ((events & Event::Addr) != Event::None) {
+        get_cache(Cache::Addr);
+    }
+    if ((events & Event::Route) != Event::None) {
+        get_cache(Cache::Route);
+    }
+    if ((events & Event::Neigh) != Event::None) {
+        get_cache(Cache::Neigh);
+    }
+
+    int const id = m_next_subscription++;
+    m_subscriptions.push_back({id, events, std::move(callback)});
+    m_subscribed_events = m_subscribed_events | events;
+    return id;
+}
+void ShowInfoInterface::unsubscribe(int const subscription) {
+    std::erase_if(m_subscriptions, [subscription](Subscription const &item) { return item.id == subscription; });
+
+    m_subscribed_events = Event::None;
+    for (auto const &item : m_subscriptions) {
+        m_subscribed_events = m_subscribed_events | item.events;
+    }
+    if (m_subscribed_events == Event::None) {
+        m_events.clear();
+    }
+}
+void ShowInfoInterface::record_events(Cache const kind, nl_object *old_obj, nl_object *new_obj, int const action) {
+    nl_object *const obj = new_obj ? new_obj : old_obj;
+    if (!obj) {
+        return;
+    }
+
+    InterfaceEvent event;
+    event.received = std::chrono::steady_clock::now();
+    char buffer[100];
+
+    switch (kind) {
+        case Cache::Link: {
+            auto *const link = reinterpret_cast<struct rtnl_link *>(obj);
+            if (!is_device_link(link)) {
+                // Уведомления о параметрах IPv6 и порта моста (RTM_NEWLINK с AF_INET6/AF_BRIDGE) хранятся в кэше отдельными объектами.
+                return;
+            }
+            event.ifindex = rtnl_link_get_ifindex(link);
+            if (char const *if_name = rtnl_link_get_name(link)) {
+                event.interface = if_name;
+            }
+            event.flags = rtnl_link_get_flags(link);
+            event.mtu = rtnl_link_get_mtu(link);
+
+            if (action == NL_ACT_NEW) {
+                event.type = Event::LinkAdded;
+                push_event(std::move(event));
+                return;
+            }
+            if (action == NL_ACT_DEL) {
+                event.type = Event::LinkRemoved;
+                push_event(std::move(event));
+                return;
+            }
+            if (!old_obj || !new_obj) {
+                return;
+            }
+
+            auto *const old_link = reinterpret_cast<struct rtnl_link *>(old_obj);
+            event.previous_flags = rtnl_link_get_flags(old_link);
+            event.previous_mtu = rtnl_link_get_mtu(old_link);
+
+            unsigned const changed = event.flags ^ event.previous_flags;
+            if (changed & IFF_UP) {
+                InterfaceEvent copy = event;
+                copy.type = (event.flags & IFF_UP) ? Event::LinkUp : Event::LinkDown;
+                push_event(std::move(copy));
+            }
+            if (changed & IFF_LOWER_UP) {
+                InterfaceEvent copy = event;
+                copy.type = (event.flags & IFF_LOWER_UP) ? Event::CarrierUp : Event::CarrierDown;
+                push_event(std::move(copy));
+            }
+            if (event.mtu != event.previous_mtu) {
+                event.type = Event::MtuChanged;
+                push_event(std::move(event));
+            }
+            return;
+        }
+        case Cache::Addr: {
+            if (action == NL_ACT_CHANGE) {
+                return;
+            }
+            auto *const addr = reinterpret_cast<struct rtnl_addr *>(obj);
+            event.type = action == NL_ACT_NEW ? Event::AddrAdded : Event::AddrRemoved;
+            event.ifindex = rtnl_addr_get_ifindex(addr);
+            event.family = rtnl_addr_get_family(addr);
+            if (auto const local = rtnl_addr_get_local(addr)) {
+                event.address = nl_addr2str(local, buffer, sizeof(buffer));
+            }
+            push_event(std::move(event));
+            return;
+        }
+        case Cache::Route: {
+            if (action == NL_ACT_CHANGE) {
+                return;
+            }
+            auto *const route = reinterpret_cast<struct rtnl_route *>(obj);
+            event.type = action == NL_ACT_NEW ? Event::RouteAdded : Event::RouteRemoved;
+            event.family = rtnl_route_get_family(route);
+            event.table = rtnl_route_get_table(route);
+            if (rtnl_route_get_nnexthops(route) > 0) {
+                event.ifindex = rtnl_route_nh_get_ifindex(rtnl_route_nexthop_n(route, 0));
+            }
+            auto const dst = rtnl_route_get_dst(route);
+            event.address = dst && !nl_addr_iszero(dst) ? nl_addr2str(dst, buffer, sizeof(buffer)) : "(default)";
+            push_event(std::move(event));
+            return;
+        }
+        default: {
+            auto *const neigh = reinterpret_cast<struct rtnl_neigh *>(obj);
+            event.ifindex = rtnl_neigh_get_ifindex(neigh);
+            event.family = rtnl_neigh_get_family(neigh);
+            event.state = static_cast<unsigned>(rtnl_neigh_get_state(neigh));
+            if (auto const dst = rtnl_neigh_get_dst(neigh)) {
+                event.address = nl_addr2str(dst, buffer, sizeof(buffer));
+            }
+            if (auto const lladdr = rtnl_neigh_get_lladdr(neigh)) {
+                event.mac = nl_addr2str(lladdr, buffer, sizeof(buffer));
+            }
+
+            if (action == NL_ACT_NEW) {
+                event.type = Event::NeighAdded;
+            } else if (action == NL_ACT_DEL) {
+                event.type = Event::NeighRemoved;
+            } else if (old_obj && new_obj) {
+                event.previous_state = static_cast<unsigned>(rtnl_neigh_get_state(reinterpret_cast<struct rtnl_neigh *>(old_obj)));
+                if (event.previous_state == event.state) {
+                    return;
+                }
+                event.type = Event::NeighStateChanged;
+            } else {
+                return;
+            }
+            push_event(std::move(event));
+        }
+    }
+}
+void ShowInfoInterface::push_event(InterfaceEvent &&event) {
+    if ((m_subscribed_events & event.type) != Event::None) {
+        m_events.push_back(std::move(event));
+    }
+}
+void ShowInfoInterface::dispatch_events() {
+    if (m_events.empty()) {
+        return;
+    }
+
+    // Обработчик может подписаться, отписаться или снова применить уведомления, поэтому очередь
+    // и список подписок копируются перед доставкой.
+    std::vector<InterfaceEvent> events;
+    events.swap(m_events);
+    auto const subscriptions = m_subscriptions;
+
+    for (auto &event : events) {
+        if (event.interface.empty() && event.ifindex > 0) {
+            try {
+                if (char const *if_name = rtnl_link_get_name(find_link(event.ifindex))) {
+                    event.interface = if_name;
+                }
+            } catch (exceptions::InterfaceNotFound const &) {
+                // Интерфейс уже удалён: событие доставляется только с индексом.
+            }
+        }
+
+        for (auto const &subscription : subscriptions) {
+            if ((subscription.events & event.type) != Event::None) {
+                try {
+                    subscription.callback(event);
+                } catch (...) {
+                    // Исключение обработчика не должно прерывать refresh() и доставку остальных событий.
+                }
+            }
+        }
+    }
+}
+void ShowInfoInterface::sync_link_cache() {
+    if (m_cache_manager) {
+        // Уведомление RTM_NEWLINK ядро ставит в очередь до отправки ACK, поэтому оно уже доступно для чтения.
+        if (nl_cache_mngr_data_ready(m_cache_manager.get()) < 0) {
+            reload_caches();
+        }
+        resync_stale_routes();
+        dispatch_events();
+    } else {
+        load_cache(Cache::Link);
+    }
+}
+void ShowInfoInterface::rebuild_link_index() {
+    m_links_by_index.clear();
+    m_links_by_name.clear();
+    nl_cache *const link_data = get_cache(Cache::Link);
+    m_links_by_index.reserve(nl_cache_nitems(link_data));
+    m_links_by_name.reserve(nl_cache_nitems(link_data));
+
+    // Индекс удерживает ссылки на объекты: менеджер кэшей может заменить объект без вызова обработчика,
+    // если новое состояние не отличается от старого, и указатель без ссылки оказался бы висячим.
+    // Такой объект find_link обнаруживает по отсоединению от кэша, иначе индекс вернул бы устаревшие счётчики.
+    for (auto obj = nl_cache_get_first(link_data); obj; obj = nl_cache_get_next(obj)) {
+        auto const link = reinterpret_cast<struct rtnl_link *>(obj);
+        // Менеджер кэшей хранит в кэше интерфейсов и объекты AF_INET6/AF_BRIDGE с тем же индексом и именем.
+        if (!is_device_link(link)) {
+            continue;
+        }
+        nl_object_get(obj);
+        m_links_by_index.insert_or_assign(rtnl_link_get_ifindex(link), LinkPtr{link, rtnl_link_put});
+
+        if (char const *if_name = rtnl_link_get_name(link)) {
+            m_links_by_name.insert_or_assign(if_name, link);
+        }
+    }
+
+    m_link_index_dirty = false;
+}
+rtnl_link *ShowInfoInterface::find_link(std::string const &interface_name) {
+    if (m_link_index_dirty) {
+        rebuild_link_index();
+    }
+
+    auto it = m_links_by_name.find(interface_name);
+    // Объект, отличающийся от прежнего только счётчиками, менеджер заменяет без вызова обработчика;
+    // заменённый объект отсоединён от кэша, и индекс перестраивается только в этом случае.
+    if (it != m_links_by_name.end() && !nl_object_get_cache(OBJ_CAST(it->second))) {
+        rebuild_link_index();
+        it = m_links_by_name.find(interface_name);
+    }
+    if (it == m_links_by_name.end()) {
+        throw exceptions::InterfaceNotFound(fmt::format("Интерфейс '{}' не найден", interface_name));
+    }
+    return it->second;
+}
+rtnl_link *ShowInfoInterface::find_link(int const ifindex) {
+    if (m_link_index_dirty) {
+        rebuild_link_index();
+    }
 
-    rtnl_link *link = rtnl_link_get(m_link_data.get(), ifindex);
-    if (!link) {
-        throw exceptions::InterfaceNotFound(::fmt::format("Интерфейс {} не найден", interface_name));
+    auto it = m_links_by_index.find(ifindex);
+    if (it != m_links_by_index.end() && !nl_object_get_cache(OBJ_CAST(it->second.get()))) {
+        rebuild_link_index();
+        it = m_links_by_index.find(ifindex);
     }
+    if (it == m_links_by_index.end()) {
+        throw exceptions::InterfaceNotFound(fmt::format("Интерфейс с индексом {} не найден", ifindex));
+    }
+    return it->second.get();
+}
+void ShowInfoInterface::rebuild_addr_index() {
+    m_addr_by_link.clear();
+
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Addr)); obj; obj = nl_cache_get_next(obj)) {
+        auto const addr = reinterpret_cast<struct rtnl_addr *>(obj);
+        nl_object_get(obj);
+        m_addr_by_link[rtnl_addr_get_ifindex(addr)].emplace_back(addr, rtnl_addr_put);
+    }
+
+    m_addr_index_dirty = false;
+}
+void ShowInfoInterface::rebuild_route_index() {
+    m_routes_by_link.clear();
+
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Route)); obj; obj = nl_cache_get_next(obj)) {
+        auto const route = reinterpret_cast<struct rtnl_route *>(obj);
+
+        // Маршрут попадает в корзину каждого интерфейса, через который идёт хотя бы один его nexthop (без повторов).
+        int const next_hops = rtnl_route_get_nnexthops(route);
+        for (int i = 0; i < next_hops; i++) {
+            int const ifindex = rtnl_route_nh_get_ifindex(rtnl_route_nexthop_n(route, i));
+
+            bool seen = false;
+            for (int j = 0; j < i && !seen; j++) {
+                seen = rtnl_route_nh_get_ifindex(rtnl_route_nexthop_n(route, j)) == ifindex;
+            }
+            if (seen) {
+                continue;
+            }
+
+            nl_object_get(obj);
+            m_routes_by_link[ifindex].emplace_back(route, rtnl_route_put);
+        }
+    }
+
+    m_route_index_dirty = false;
+}
+void ShowInfoInterface::rebuild_route_lookup() {
+    m_route_lookup.clear();
+
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Route)); obj; obj = nl_cache_get_next(obj)) {
+        m_route_lookup.add(reinterpret_cast<struct rtnl_route *>(obj));
+    }
+
+    m_route_lookup_dirty = false;
+}
+void ShowInfoInterface::rebuild_neigh_index() {
+    m_neigh_by_link.clear();
+
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Neigh)); obj; obj = nl_cache_get_next(obj)) {
+        auto const neigh = reinterpret_cast<struct rtnl_neigh *>(obj);
+        nl_object_get(obj);
+        m_neigh_by_link[rtnl_neigh_get_ifindex(neigh)].emplace_back(neigh, rtnl_neigh_put);
+    }
+
+    m_neigh_index_dirty = false;
+}
+void ShowInfoInterface::rebuild_neigh_lookup() {
+    m_neigh_lookup.clear();
+
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Neigh)); obj; obj = nl_cache_get_next(obj)) {
+        m_neigh_lookup.add(reinterpret_cast<struct rtnl_neigh *>(obj));
+    }
+
+    m_neigh_lookup_dirty = false;
+}
+void ShowInfoInterface::enable_interface(std::string const &interface_name) {
+    rtnl_link *link = find_link(interface_name);
 
     rtnl_link *change = rtnl_link_alloc();
     rtnl_link_set_flags(change, IFF_UP);
 
-    int const ret = rtnl_link_change(m_netlink_socket.get(), link, change, 0);
-    rtnl_link_put(link);
+    int const ret = rtnl_link_change(control_socket(), link, change, 0);
     rtnl_link_put(change);
 
     if (ret < 0) {
         throw exceptions::InterfaceOperationEx(::fmt::format("Не удалось включить интерфейс {}: {}", interface_name, nl_geterror(ret)));
     }
 
-    nl_cache_refill(m_netlink_socket.get(), m_link_data.get());
+    sync_link_cache();
 }
 
 void ShowInfoInterface::disable_interface(std::string const &interface_name) {
-    int const ifindex = getInterfaceIndex(interface_name);
-
-    rtnl_link *link = rtnl_link_get(m_link_data.get(), ifindex);
-    if (!link) {
-        throw exceptions::InterfaceNotFound(::fmt::format("Интерфейс {} не найден", interface_name));
-    }
+    rtnl_link *link = find_link(interface_name);
 
     rtnl_link *change = rtnl_link_alloc();
     rtnl_link_unset_flags(change, IFF_UP);
 
-    int const ret = rtnl_link_change(m_netlink_socket.get(), link, change, 0);
-    rtnl_link_put(link);
+    int const ret = rtnl_link_change(control_socket(), link, change, 0);
     rtnl_link_put(change);
 
     if (ret < 0) {
         throw exceptions::InterfaceOperationEx(::fmt::format("Не удалось выключить интерфейс {}: {}", interface_name, nl_geterror(ret)));
     }
 
-    nl_cache_refill(m_netlink_socket.get(), m_link_data.get());
+    sync_link_cache();
 }
-nlohmann::json ShowInfoInterface::get_interface_info(std::string const &interface_name) {
+std::vector<InterfaceChangeResult> ShowInfoInterface::set_interfaces_state(std::vector<InterfaceStateChange> const &changes) {
+    nl_sock *const socket = control_socket();
+    std::vector<InterfaceChangeResult> results(changes.size());
+
+    // Интерфейсы находятся заранее: обработка уведомлений между пачками перестраивает индекс.
+    std::vector<LinkPtr> links;
+    links.reserve(changes.size());
+    for (std::size_t i = 0; i < changes.size(); ++i) {
+        results[i].interface_name = changes[i].interface_name;
+        try {
+            rtnl_link *const link = find_link(changes[i].interface_name);
+            nl_object_get(OBJ_CAST(link));
+            links.emplace_back(link, rtnl_link_put);
+        } catch (exceptions::InterfaceNotFound const &ex) {
+            results[i].error = ENODEV;
+            results[i].message = ex.what();
+            links.emplace_back(nullptr, rtnl_link_put);
+        }
+    }
+
+    PendingChanges pending{{}, &results};
+    std::vector<char> buffer;
+    bool applied = false;
+    bool resync = false;
+    for (std::size_t begin = 0; begin < changes.size(); begin += M_CHANGE_BATCH_SIZE) {
+        std::size_t const end = std::min(changes.size(), begin + M_CHANGE_BATCH_SIZE);
+        buffer.clear();
+        pending.by_seq.clear();
+
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!links[i]) {
+                continue;
+            }
+
+            LinkPtr const change{rtnl_link_alloc(), rtnl_link_put};
+            if (changes[i].up) {
+                rtnl_link_set_flags(change.get(), IFF_UP);
+            } else {
+                rtnl_link_unset_flags(change.get(), IFF_UP);
+            }
+
+            nl_msg *msg = nullptr;
+            if (int const ret = rtnl_link_build_change_request(links[i].get(), change.get(), 0, &msg); ret < 0) {
+                results[i].error = ENOMEM;
+                results[i].message = ::fmt::format("Не удалось сформировать запрос для интерфейса {}: {}", changes[i].interface_name, nl_geterror(ret));
+                continue;
+            }
+
+            // Порядковый номер и флаг NLM_F_ACK назначаются так же, как при nl_send_auto.
+            nl_complete_msg(socket, msg);
+            nlmsghdr const *const header = nlmsg_hdr(msg);
+            pending.by_seq.emplace(header->nlmsg_seq, i);
+            auto const *const bytes = reinterpret_cast<char const *>(header);
+            buffer.insert(buffer.end(), bytes, bytes + NLMSG_ALIGN(header->nlmsg_len));
+            nlmsg_free(msg);
+        }
+
+        if (pending.by_seq.empty()) {
+            continue;
+        }
+        send_change_batch(buffer, pending);
+        applied = true;
+
+        // Уведомления об изменениях разбираются после каждой пачки, чтобы не переполнить буфер сокета менеджера.
+        if (m_cache_manager && nl_cache_mngr_data_ready(m_cache_manager.get()) < 0) {
+            resync = true;
+        }
+    }
+
+    if (applied) {
+        sync_link_cache();
+        if (resync && m_cache_manager) {
+            // Часть уведомлений потеряна: кэши приводятся в порядок полным дампом.
+            reload_caches();
+        }
+    }
+    return results;
+}
+void ShowInfoInterface::send_change_batch(std::vector<char> const &buffer, PendingChanges &pending) {
+    std::unique_ptr<nl_cb, decltype(&nl_cb_put)> const callbacks{nl_cb_alloc(NL_CB_DEFAULT), nl_cb_put};
+    if (!callbacks) {
+        throw exceptions::InterfaceOperationEx("Не удалось выделить обработчики Netlink");
+    }
+    nl_cb_set(callbacks.get(), NL_CB_ACK, NL_CB_CUSTOM, on_change_ack, &pending);
+    nl_cb_err(callbacks.get(), NL_CB_CUSTOM, on_change_error, &pending);
+    // Подтверждения сопоставляются по порядковому номеру: запоздавшее подтверждение пачки, не дождавшейся
+    // ответа, при строгой проверке libnl отвергло бы следующую пачку.
+    nl_cb_set(callbacks.get(), NL_CB_SEQ_CHECK, NL_CB_CUSTOM, [](nl_msg *, void *) { return static_cast<int>(NL_OK); }, nullptr);
+
+    nl_sock *const socket = control_socket();
+    if (int const ret = nl_sendto(socket, const_cast<char *>(buffer.data()), buffer.size()); ret < 0) {
+        throw exceptions::InterfaceOperationEx(::fmt::format("Не удалось отправить пакет запросов: {}", nl_geterror(ret)));
+    }
+
+    // Сокет блокирующий: без ограничения потерянное подтверждение оставило бы nl_recvmsgs ждать бесконечно.
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{M_ACK_TIMEOUT_MS};
+    while (!pending.by_seq.empty()) {
+        auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        pollfd descriptor{nl_socket_get_fd(socket), POLLIN, 0};
+        int const ready = remaining > 0 ? ::poll(&descriptor, 1, static_cast<int>(remaining)) : 0;
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready < 0) {
+            int const error = errno;
+            fail_pending_changes(pending, error, ::fmt::format("ожидание подтверждения: {}", std::strerror(error)));
+            return;
+        }
+        if (ready == 0) {
+            fail_pending_changes(pending, ETIMEDOUT, ::fmt::format("подтверждение не получено за {} мс", M_ACK_TIMEOUT_MS));
+            return;
+        }
+        if (int const ret = nl_recvmsgs(socket, callbacks.get()); ret < 0) {
+            // Переполнение приёмного буфера (ENOBUFS): часть подтверждений потеряна, и узнать, какие
+            // именно запросы применены, уже нельзя.
+            fail_pending_changes(pending, ret == -NLE_NOMEM ? ENOBUFS : EIO, ::fmt::format("подтверждение не получено: {}", nl_geterror(ret)));
+            return;
+        }
+    }
+}
+void ShowInfoInterface::fail_pending_changes(PendingChanges &pending, int const error, std::string const &reason) {
+    for (auto const &[seq, position] : pending.by_seq) {
+        auto &result = (*pending.results)[position];
+        result.error = error;
+        result.message = ::fmt::format("Не удалось изменить состояние интерфейса {}: {}", result.interface_name, reason);
+    }
+    pending.by_seq.clear();
+}
+int ShowInfoInterface::on_change_ack(nl_msg *msg, void *data) {
+    auto *const pending = static_cast<PendingChanges *>(data);
+    pending->by_seq.erase(nlmsg_hdr(msg)->nlmsg_seq);
+    return NL_OK;
+}
+int ShowInfoInterface::on_change_error(sockaddr_nl *, nlmsgerr *error, void *data) {
+    auto *const pending = static_cast<PendingChanges *>(data);
+
+    auto const it = pending->by_seq.find(error->msg.nlmsg_seq);
+    if (it != pending->by_seq.end()) {
+        auto &result = (*pending->results)[it->second];
+        result.error = -error->error;
+        result.message = ::fmt::format("Не удалось изменить состояние интерфейса {}: {}", result.interface_name, std::strerror(result.error));
+        pending->by_seq.erase(it);
+    }
+    return NL_SKIP;
+}
+nlohmann::json ShowInfoInterface::get_interface_info(std::string const &interface_name, Section const sections) {
     try {
-        showInterface(interface_name);
+        showInterface(interface_name, sections);
 
-        return m_json;
+        return project_json(m_json, sections);
     } catch (std::exception const &ex) {
         return {{"error", ex.what()}};
     }
 }
+nlohmann::json ShowInfoInterface::get_all_interfaces_info(Section const sections) {
+    nlohmann::json json{};
+    nlohmann::json interfaces = nlohmann::json::array();
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Link)); obj; obj = nl_cache_get_next(obj)) {
+        auto const link = reinterpret_cast<struct rtnl_link *>(obj);
+        if (!is_device_link(link)) {
+            continue;
+        }
+        try {
+            showInterfaceByLink(link, sections);
+            interfaces.emplace_back(project_json(m_json, sections));
+        } catch (std::exception const &ex) {
+            interfaces.push_back({{"error", ex.what()}});
+        }
+    }
+    json["interfaces"] = interfaces;
+    return json;
+}
+nlohmann::json ShowInfoInterface::get_interfaces_info(std::vector<std::string> const &interface_names, Section const sections) {
+    nlohmann::json json{};
+    nlohmann::json interfaces = nlohmann::json::array();
+    for (auto const &interface_name : interface_names) {
+        try {
+            showInterface(interface_name, sections);
+            interfaces.emplace_back(project_json(m_json, sections));
+        } catch (std::exception const &ex) {
+            interfaces.push_back({{"error", ex.what()}});
+        }
+    }
+    json["interfaces"] = interfaces;
+    return json;
+}
+Json ShowInfoInterface::get_interface_data(std::string const &interface_name, Section const sections) {
+    showInterface(interface_name, sections);
+
+    return std::move(m_json);
+}
+std::vector<Json> ShowInfoInterface::get_all_interfaces_data(Section const sections) {
+    nl_cache *const links = get_cache(Cache::Link);
+
+    std::vector<Json> interfaces;
+    interfaces.reserve(static_cast<std::size_t>(nl_cache_nitems(links)));
+    for (auto obj = nl_cache_get_first(links); obj; obj = nl_cache_get_next(obj)) {
+        auto const link = reinterpret_cast<struct rtnl_link *>(obj);
+        if (!is_device_link(link)) {
+            continue;
+        }
+        showInterfaceByLink(link, sections);
+        interfaces.emplace_back(std::move(m_json));
+    }
+    return interfaces;
+}
+std::vector<Json> ShowInfoInterface::get_interfaces_data(std::vector<std::string> const &interface_names, Section const sections) {
+    std::vector<Json> interfaces;
+    interfaces.reserve(interface_names.size());
+    for (auto const &interface_name : interface_names) {
+        showInterface(interface_name, sections);
+        interfaces.emplace_back(std::move(m_json));
+    }
+    return interfaces;
+}
 nlohmann::json ShowInfoInterface::get_all_interfaces() {
     nlohmann::json json{};
     nlohmann::json interfaces = nlohmann::json::array();
-    for (auto obj = nl_cache_get_first(m_link_data.get()); obj; obj = nl_cache_get_next(obj)) {
+    for (auto obj = nl_cache_get_first(get_cache(Cache::Link)); obj; obj = nl_cache_get_next(obj)) {
         auto const link = reinterpret_cast<struct rtnl_link *>(obj);
+        if (!is_device_link(link)) {
+            continue;
+        }
         std::string interface(rtnl_link_get_name(link));
         interfaces.emplace_back(std::move(interface));
     }
     json["interfaces"] = interfaces;
     return json;
 }
+int ShowInfoInterface::get_event_fd() const {
+    if (!m_cache_manager) {
+        return -1;
+    }
+    return nl_cache_mngr_get_fd(m_cache_manager.get());
+}
+std::optional<RouteMatch> ShowInfoInterface::lookup_route(std::string const &address, uint32_t const table) {
+    unsigned char bytes[16];
+    int const family = parse_ip(address, bytes);
+    // Индекс строится из ограниченного кэша: без отброшенных маршрутов поиск выбрал бы не тот маршрут.
+    if (!m_scope.interface.empty() || (m_scope.family != AF_UNSPEC && m_scope.family != family) ||
+        (m_scope.table != 0 && m_scope.table != table)) {
+        throw exceptions::OutOfScope(::fmt::format("Route lookup for {} in table {} is outside the dump scope", address, table));
+    }
+
+    if (m_cache_manager) {
+        resync_stale_routes();
+    }
+    if (m_route_lookup_dirty) {
+        rebuild_route_lookup();
+    }
+
+    // Правила по умолчанию: local, main, default; маршрут THROW передаёт поиск следующей таблице.
+    constexpr uint32_t default_tables[] = {RT_TABLE_LOCAL, RT_TABLE_MAIN, RT_TABLE_DEFAULT};
+    rtnl_route *route = nullptr;
+    if (table != 0) {
+        route = m_route_lookup.lookup(family, bytes, table);
+    } else {
+        for (uint32_t const candidate : default_tables) {
+            route = m_route_lookup.lookup(family, bytes, candidate);
+            if (route && rtnl_route_get_type(route) != RTN_THROW) {
+                break;
+            }
+            route = nullptr;
+        }
+    }
+    if (!route || rtnl_route_get_type(route) == RTN_THROW) {
+        return std::nullopt;
+    }
+
+    RouteMatch match;
+    match.route = route_to_info(route);
+    if (auto const dst = rtnl_route_get_dst(route)) {
+        match.prefix_length = static_cast<int>(nl_addr_get_prefixlen(dst));
+    }
+    if (int const next_hops = rtnl_route_get_nnexthops(route); next_hops > 0) {
+        match.ifindex = rtnl_route_nh_get_ifindex(rtnl_route_nexthop_n(route, next_hops - 1));
+    }
+    if (match.ifindex > 0) {
+        try {
+            if (char const *if_name = rtnl_link_get_name(find_link(match.ifindex))) {
+                match.interface = if_name;
+            }
+        } catch (exceptions::InterfaceNotFound const &) {
+            // Интерфейс удалён, а уведомление об удалении маршрута ещё не обработано.
+        }
+    }
+    return match;
+}
+std::optional<NeighbourEntry> ShowInfoInterface::get_neighbour(std::string const &interface_name, std::string const &address) {
+    int const ifindex = rtnl_link_get_ifindex(find_link(interface_name));
+    unsigned char bytes[16];
+    int const family = parse_ip(address, bytes);
+
+    if (m_neigh_lookup_dirty) {
+        rebuild_neigh_lookup();
+    }
+
+    rtnl_neigh *const neigh = m_neigh_lookup.lookup(ifindex, family, bytes);
+    if (!neigh) {
+        return std::nullopt;
+    }
+    return neigh_to_entry(neigh);
+}
+std::vector<NeighbourEntry> ShowInfoInterface::get_neighbours(NeighbourFilter const &filter) {
+    std::vector<NeighbourEntry> entries;
+    NeighbourDump dump{this, &filter, 0, &entries};
+    if (!filter.interface.empty()) {
+        dump.ifindex = rtnl_link_get_ifindex(find_link(filter.interface));
+    }
+
+    if (int const ret = m_data_source->dump(Cache::Neigh, DumpFilter{filter.family, dump.ifindex}, on_neighbour_message, &dump); ret < 0) {
+        throw exceptions::GetDataNeigh(::fmt::format("Dump neighbours: {}", nl_geterror(ret)));
+    }
+    return entries;
+}
+int ShowInfoInterface::on_neighbour_message(nl_msg *msg, void *data) {
+    auto *const dump = static_cast<NeighbourDump *>(data);
+    nlmsghdr *const header = nlmsg_hdr(msg);
+    if (header->nlmsg_type != RTM_NEWNEIGH || !nlmsg_valid_hdr(header, sizeof(ndmsg))) {
+        return NL_OK;
+    }
+
+    // Условия проверяются и здесь: ядро может не поддерживать фильтр, а запись дампа содержит все записи.
+    auto const *const ndm = static_cast<ndmsg const *>(nlmsg_data(header));
+    if ((dump->ifindex != 0 && ndm->ndm_ifindex != dump->ifindex) || (dump->filter->family != AF_UNSPEC && ndm->ndm_family != dump->filter->family) ||
+        (dump->filter->states != 0 && (ndm->ndm_state & dump->filter->states) == 0) || (ndm->ndm_flags & NTF_PROXY) != 0) {
+        return NL_OK;
+    }
+
+    rtnl_neigh *parsed = nullptr;
+    if (rtnl_neigh_parse(header, &parsed) < 0) {
+        return NL_OK;
+    }
+    NeighPtr const neigh{parsed, rtnl_neigh_put};
+    if (rtnl_neigh_get_dst(neigh.get())) {
+        dump->entries->push_back(dump->self->neigh_to_entry(neigh.get()));
+    }
+    return NL_OK;
+}
+int ShowInfoInterface::refresh(int const timeout_ms) {
+    if (m_cache_manager) {
+        int const ret = timeout_ms == 0 ? nl_cache_mngr_data_ready(m_cache_manager.get()) : nl_cache_mngr_poll(m_cache_manager.get(), timeout_ms);
+        if (ret < 0) {
+            // Уведомления, оставшиеся после ошибки, потеряны: кэши перезагружаются, чтобы следующий вызов
+            // работал с актуальным состоянием.
+            reload_caches();
+            throw exceptions::InterfaceOperationEx(::fmt::format("Не удалось обработать уведомления: {}", nl_geterror(ret)));
+        }
+        resync_stale_routes();
+        dispatch_events();
+        return ret;
+    }
+
+    return reload_caches();
+}
+int ShowInfoInterface::reload_caches() {
+    int reloaded = 0;
+    for (auto const kind : {Cache::Link, Cache::Addr, Cache::Route, Cache::Neigh}) {
+        if (cache_slot(kind)) {
+            load_cache(kind);
+            ++reloaded;
+        }
+    }
+    return reloaded;
+}
+nlohmann::json ShowInfoInterface::project_json(Json const &json, Section const sections) {
+    if (sections == Section::All) {
+        return json;
+    }
+
+    nlohmann::json result{{"interface", json.interface}};
+    if (has_section(sections, Section::General)) {
+        result["general"] = json.general;
+    }
+    if (has_section(sections, Section::HW)) {
+        result["hw"] = json.hw;
+    }
+    if (has_section(sections, Section::OperationalStatus)) {
+        result["operational_status"] = json.operational_status;
+    }
+    if (has_section(sections, Section::Protocols)) {
+        result["protocols"] = json.protocols;
+    }
+    if (has_section(sections, Section::Ip)) {
+        result["ip"] = json.ip;
+    }
+    if (has_section(sections, Section::Routes)) {
+        result["routes"] = json.routes;
+    }
+    if (has_section(sections, Section::Neigh)) {
+        result["neigh"] = json.neigh;
+    }
+    if (has_section(sections, Section::Tx)) {
+        result["tx"] = json.tx;
+    }
+    if (has_section(sections, Section::Rx)) {
+        result["rx"] = json.rx;
+    }
+    return result;
+}
 std::string ShowInfoInterface::arp_hrd_type_to_string(unsigned int const type) {
     switch (type) {
         case ARPHRD_ETHER:
@@ -148,136 +1138,149 @@ std::string ShowInfoInterface::arp_hrd_type_to_string(unsigned int const type) {
     }
 }
 
-void ShowInfoInterface::print_interface_details(rtnl_link *link) {
+void ShowInfoInterface::print_interface_details(rtnl_link *link, Section const sections) {
     std::string const if_name = rtnl_link_get_name(link);
 
     m_json.interface = if_name;
 
-    m_json.general.index = rtnl_link_get_ifindex(link);
-
     unsigned int const flags = rtnl_link_get_flags(link);
-    m_json.general.state = ((flags & IFF_UP) ? "UP" : "DOWN");
-
-    if (flags & IFF_LOOPBACK) {
-        m_json.general.type = "LOOPBACK";
-    } else if (flags & IFF_BROADCAST) {
-        m_json.general.type = "BROADCAST";
-    } else if (flags & IFF_POINTOPOINT) {
-        m_json.general.type = "POINT-TO-POINT";
-    } else {
-        m_json.general.type = "UNKNOWN";
-    }
 
-    if (flags & IFF_UP) {
-        m_json.general.flags.emplace_back("UP");
-    }
-    if (flags & IFF_BROADCAST) {
-        m_json.general.flags.emplace_back("BROADCAST");
-    }
-    if (flags & IFF_DEBUG) {
-        m_json.general.flags.emplace_back("DEBUG");
-    }
-    if (flags & IFF_LOOPBACK) {
-        m_json.general.flags.emplace_back("LOOPBACK");
-    }
-    if (flags & IFF_POINTOPOINT) {
-        m_json.general.flags.emplace_back("POINTOPOINT");
-    }
-    if (flags & IFF_RUNNING) {
-        m_json.general.flags.emplace_back("RUNNING");
-    }
-    if (flags & IFF_NOARP) {
-        m_json.general.flags.emplace_back("NOARP");
-    }
-    if (flags & IFF_PROMISC) {
-        m_json.general.flags.emplace_back("PROMISC");
-    }
-    if (flags & IFF_ALLMULTI) {
-        m_json.general.flags.emplace_back("ALLMULTI");
-    }
-    if (flags & IFF_MASTER) {
-        m_json.general.flags.emplace_back("MASTER");
-    }
-    if (flags & IFF_SLAVE) {
-        m_json.general.flags.emplace_back("SLAVE");
-    }
-    if (flags & IFF_MULTICAST) {
-        m_json.general.flags.emplace_back("MULTICAST");
-    }
-    if (flags & IFF_PORTSEL) {
-        m_json.general.flags.emplace_back("PORTSEL");
-    }
-    if (flags & IFF_AUTOMEDIA) {
-        m_json.general.flags.emplace_back("AUTOMEDIA");
-    }
-    if (flags & IFF_DYNAMIC) {
-        m_json.general.flags.emplace_back("DYNAMIC");
-    }
+    if (has_section(sections, Section::General)) {
+        m_json.general.index = rtnl_link_get_ifindex(link);
 
-    unsigned int const arp_type = rtnl_link_get_arptype(link);
-    m_json.hw.type = arp_hrd_type_to_string(arp_type);
+        m_json.general.state = ((flags & IFF_UP) ? "UP" : "DOWN");
 
-    if (auto const hw_addr = rtnl_link_get_addr(link)) {
-        char mac_str[20];
-        nl_addr2str(hw_addr, mac_str, sizeof(mac_str));
-        m_json.hw.mac.emplace_back(mac_str);
+        if (flags & IFF_LOOPBACK) {
+            m_json.general.type = "LOOPBACK";
+        } else if (flags & IFF_BROADCAST) {
+            m_json.general.type = "BROADCAST";
+        } else if (flags & IFF_POINTOPOINT) {
+            m_json.general.type = "POINT-TO-POINT";
+        } else {
+            m_json.general.type = "UNKNOWN";
+        }
+
+        if (flags & IFF_UP) {
+            m_json.general.flags.emplace_back("UP");
+        }
+        if (flags & IFF_BROADCAST) {
+            m_json.general.flags.emplace_back("BROADCAST");
+        }
+        if (flags & IFF_DEBUG) {
+            m_json.general.flags.emplace_back("DEBUG");
+        }
+        if (flags & IFF_LOOPBACK) {
+            m_json.general.flags.emplace_back("LOOPBACK");
+        }
+        if (flags & IFF_POINTOPOINT) {
+            m_json.general.flags.emplace_back("POINTOPOINT");
+        }
+        if (flags & IFF_RUNNING) {
+            m_json.general.flags.emplace_back("RUNNING");
+        }
+        if (flags & IFF_NOARP) {
+            m_json.general.flags.emplace_back("NOARP");
+        }
+        if (flags & IFF_PROMISC) {
+            m_json.general.flags.emplace_back("PROMISC");
+        }
+        if (flags & IFF_ALLMULTI) {
+            m_json.general.flags.emplace_back("ALLMULTI");
+        }
+        if (flags & IFF_MASTER) {
+            m_json.general.flags.emplace_back("MASTER");
+        }
+        if (flags & IFF_SLAVE) {
+            m_json.general.flags.emplace_back("SLAVE");
+        }
+        if (flags & IFF_MULTICAST) {
+            m_json.general.flags.emplace_back("MULTICAST");
+        }
+        if (flags & IFF_PORTSEL) {
+            m_json.general.flags.emplace_back("PORTSEL");
+        }
+        if (flags & IFF_AUTOMEDIA) {
+            m_json.general.flags.emplace_back("AUTOMEDIA");
+        }
+        if (flags & IFF_DYNAMIC) {
+            m_json.general.flags.emplace_back("DYNAMIC");
+        }
     }
 
-    m_json.hw.mtu = rtnl_link_get_mtu(link);
+    if (has_section(sections, Section::HW)) {
+        unsigned int const arp_type = rtnl_link_get_arptype(link);
+        m_json.hw.type = arp_hrd_type_to_string(arp_type);
 
-    if (unsigned int const txq_len = rtnl_link_get_txqlen(link); txq_len >= 0) {
-        m_json.hw.size_queue = txq_len;
-    }
+        if (auto const hw_addr = rtnl_link_get_addr(link)) {
+            char mac_str[20];
+            nl_addr2str(hw_addr, mac_str, sizeof(mac_str));
+            m_json.hw.mac.emplace_back(mac_str);
+        }
 
-    switch (rtnl_link_get_operstate(link)) {
-        case IF_OPER_UNKNOWN:
-            m_json.operational_status.oper_state = "UNKNOWN";
-            break;
-        case IF_OPER_NOTPRESENT:
-            m_json.operational_status.oper_state = "NOT PRESENT";
-            break;
-        case IF_OPER_DOWN:
-            m_json.operational_status.oper_state = "DOWN";
-            break;
-        case IF_OPER_LOWERLAYERDOWN:
-            m_json.operational_status.oper_state = "LOWER LAYER DOWN";
-            break;
-        case IF_OPER_TESTING:
-            m_json.operational_status.oper_state = "TESTING";
-            break;
-        case IF_OPER_DORMANT:
-            m_json.operational_status.oper_state = "DORMANT";
-            break;
-        case IF_OPER_UP:
-            m_json.operational_status.oper_state = "UP";
-            break;
-        default:
-            m_json.operational_status.oper_state = "UNDEFINED";
+        m_json.hw.mtu = rtnl_link_get_mtu(link);
+
+        if (unsigned int const txq_len = rtnl_link_get_txqlen(link); txq_len >= 0) {
+            m_json.hw.size_queue = txq_len;
+        }
     }
 
-    switch (rtnl_link_get_linkmode(link)) {
-        case IF_LINK_MODE_DEFAULT:
-            m_json.operational_status.link_mode = "DEFAULT";
-            break;
-        case IF_LINK_MODE_DORMANT:
-            m_json.operational_status.link_mode = "DORMANT";
-            break;
-        default:
-            m_json.operational_status.link_mode = "UNKNOWN";
+    if (has_section(sections, Section::OperationalStatus)) {
+        switch (rtnl_link_get_operstate(link)) {
+            case IF_OPER_UNKNOWN:
+                m_json.operational_status.oper_state = "UNKNOWN";
+                break;
+            case IF_OPER_NOTPRESENT:
+                m_json.operational_status.oper_state = "NOT PRESENT";
+                break;
+            case IF_OPER_DOWN:
+                m_json.operational_status.oper_state = "DOWN";
+                break;
+            case IF_OPER_LOWERLAYERDOWN:
+                m_json.operational_status.oper_state = "LOWER LAYER DOWN";
+                break;
+            case IF_OPER_TESTING:
+                m_json.operational_status.oper_state = "TESTING";
+                break;
+            case IF_OPER_DORMANT:
+                m_json.operational_status.oper_state = "DORMANT";
+                break;
+            case IF_OPER_UP:
+                m_json.operational_status.oper_state = "UP";
+                break;
+            default:
+                m_json.operational_status.oper_state = "UNDEFINED";
+        }
+
+        switch (rtnl_link_get_linkmode(link)) {
+            case IF_LINK_MODE_DEFAULT:
+                m_json.operational_status.link_mode = "DEFAULT";
+                break;
+            case IF_LINK_MODE_DORMANT:
+                m_json.operational_status.link_mode = "DORMANT";
+                break;
+            default:
+                m_json.operational_status.link_mode = "UNKNOWN";
+        }
     }
 
-    m_json.rx.bytes = rtnl_link_get_stat(link, RTNL_LINK_RX_BYTES);
-    m_json.rx.packets = rtnl_link_get_stat(link, RTNL_LINK_RX_PACKETS);
-    m_json.rx.errors = rtnl_link_get_stat(link, RTNL_LINK_RX_ERRORS);
-    m_json.rx.drops = rtnl_link_get_stat(link, RTNL_LINK_RX_DROPPED);
+    if (has_section(sections, Section::Rx)) {
+        m_json.rx.bytes = rtnl_link_get_stat(link, RTNL_LINK_RX_BYTES);
+        m_json.rx.packets = rtnl_link_get_stat(link, RTNL_LINK_RX_PACKETS);
+        m_json.rx.errors = rtnl_link_get_stat(link, RTNL_LINK_RX_ERRORS);
+        m_json.rx.drops = rtnl_link_get_stat(link, RTNL_LINK_RX_DROPPED);
+    }
 
-    m_json.tx.bytes = rtnl_link_get_stat(link, RTNL_LINK_TX_BYTES);
-    m_json.tx.packets = rtnl_link_get_stat(link, RTNL_LINK_TX_PACKETS);
-    m_json.tx.errors = rtnl_link_get_stat(link, RTNL_LINK_TX_ERRORS);
-    m_json.tx.drops = rtnl_link_get_stat(link, RTNL_LINK_TX_DROPPED);
+    if (has_section(sections, Section::Tx)) {
+        m_json.tx.bytes = rtnl_link_get_stat(link, RTNL_LINK_TX_BYTES);
+        m_json.tx.packets = rtnl_link_get_stat(link, RTNL_LINK_TX_PACKETS);
+        m_json.tx.errors = rtnl_link_get_stat(link, RTNL_LINK_TX_ERRORS);
+        m_json.tx.drops = rtnl_link_get_stat(link, RTNL_LINK_TX_DROPPED);
+    }
 
-    m_json.protocols.routing_ipv4 = (flags & IFF_NOARP) ? false : true;
-    m_json.protocols.multicast = (flags & IFF_MULTICAST) ? true : false;
+    if (has_section(sections, Section::Protocols)) {
+        m_json.protocols.routing_ipv4 = (flags & IFF_NOARP) ? false : true;
+        m_json.protocols.multicast = (flags & IFF_MULTICAST) ? true : false;
+    }
 }
 void ShowInfoInterface::print_address_info(rtnl_addr *addr) {
     auto const local = rtnl_addr_get_local(addr);
@@ -354,191 +1357,229 @@ void ShowInfoInterface::print_address_info(rtnl_addr *addr) {
     m_json.ip.emplace_back(ip);
 }
 void ShowInfoInterface::print_neighbour_info(int const ifindex) {
-    Neigh neigh_json;
+    if (m_neigh_index_dirty) {
+        rebuild_neigh_index();
+    }
 
-    for (auto obj = nl_cache_get_first(m_neigh_data.get()); obj; obj = nl_cache_get_next(obj)) {
-        auto const neigh = reinterpret_cast<struct rtnl_neigh *>(obj);
+    auto const bucket = m_neigh_by_link.find(ifindex);
+    if (bucket == m_neigh_by_link.end()) {
+        return;
+    }
 
-        if (rtnl_neigh_get_ifindex(neigh) != ifindex) {
-            continue;
+    for (auto const &neigh_ptr : bucket->second) {
+        if (rtnl_neigh_get_dst(neigh_ptr.get())) {
+            m_json.neigh.emplace_back(neigh_to_info(neigh_ptr.get()));
         }
+    }
+}
+void ShowInfoInterface::print_routes_for_interface(int const ifindex) {
+    if (m_route_index_dirty) {
+        rebuild_route_index();
+    }
 
-        auto const dst = rtnl_neigh_get_dst(neigh);
-        auto const lladdr = rtnl_neigh_get_lladdr(neigh);
-
-        if (!dst) continue;
+    auto const bucket = m_routes_by_link.find(ifindex);
+    if (bucket == m_routes_by_link.end()) {
+        return;
+    }
 
-        char ip_str[100];
-        nl_addr2str(dst, ip_str, sizeof(ip_str));
+    for (auto const &route_ptr : bucket->second) {
+        m_json.routes.emplace_back(route_to_info(route_ptr.get()));
+    }
+}
+Routes ShowInfoInterface::route_to_info(rtnl_route *route) {
+    int const next_hops = rtnl_route_get_nnexthops(route);
 
-        neigh_json.ip = ip_str;
+    auto const dst = rtnl_route_get_dst(route);
+    char dst_str[100] = "(default)";
+    if (dst && !nl_addr_iszero(dst)) {
+        format_ip(dst, dst_str, sizeof(dst_str));
+    }
 
-        if (lladdr) {
-            char mac_str[20];
-            nl_addr2str(lladdr, mac_str, sizeof(mac_str));
-            neigh_json.mac = mac_str;
-        } else {
-        }
+    uint32_t const table = rtnl_route_get_table(route);
+    uint32_t const priority = rtnl_route_get_priority(route);
 
-        int const state = rtnl_neigh_get_state(neigh);
-        if (state & NUD_INCOMPLETE) {
-            neigh_json.type.emplace_back("INCOMPLETE");
-        }
-        if (state & NUD_REACHABLE) {
-            neigh_json.type.emplace_back("REACHABLE");
-        }
-        if (state & NUD_STALE) {
-            neigh_json.type.emplace_back("STALE");
-        }
-        if (state & NUD_DELAY) {
-            neigh_json.type.emplace_back("DELAY");
-        }
-        if (state & NUD_PROBE) {
-            neigh_json.type.emplace_back("PROBE");
-        }
-        if (state & NUD_FAILED) {
-            neigh_json.type.emplace_back("FAILED");
-        }
-        if (state & NUD_NOARP) {
-            neigh_json.type.emplace_back("NOARP");
-        }
-        if (state & NUD_PERMANENT) {
-            neigh_json.type.emplace_back("PERMANENT");
-        }
-        m_json.neigh.emplace_back(neigh_json);
-    }
-}
-void ShowInfoInterface::print_routes_for_interface(int const ifindex) {
     Routes routes;
+    routes.destination = dst_str;
 
-    for (auto obj = nl_cache_get_first(m_route_data.get()); obj; obj = nl_cache_get_next(obj)) {
-        auto const route = reinterpret_cast<struct rtnl_route *>(obj);
-
-        bool route_for_interface = false;
+    for (int i = 0; i < next_hops; i++) {
+        auto const nh = rtnl_route_nexthop_n(route, i);
+        auto const gateway = rtnl_route_nh_get_gateway(nh);
 
-        int const next_hops = rtnl_route_get_nnexthops(route);
-        for (int i = 0; i < next_hops; i++) {
-            if (auto const nh = rtnl_route_nexthop_n(route, i); rtnl_route_nh_get_ifindex(nh) == ifindex) {
-                route_for_interface = true;
-                break;
-            }
+        if (gateway) {
+            char gw_str[100];
+            format_ip(gateway, gw_str, sizeof(gw_str));
+            routes.gateway = gw_str;
+        } else {
+            routes.gateway = "direct";
         }
+    }
 
-        if (!route_for_interface) {
-            continue;
-        }
+    routes.metric = priority;
+    routes.table = table;
 
-        auto const dst = rtnl_route_get_dst(route);
-        char dst_str[100] = "(default)";
-        if (dst && !nl_addr_iszero(dst)) {
-            nl_addr2str(dst, dst_str, sizeof(dst_str));
-        }
+    switch (rtnl_route_get_type(route)) {
+        case RTN_UNICAST:
+            routes.type = "UNICAST";
+            break;
+        case RTN_LOCAL:
+            routes.type = "LOCAL";
+            break;
+        case RTN_BROADCAST:
+            routes.type = "BROADCAST";
+            break;
+        case RTN_ANYCAST:
+            routes.type = "ANYCAST";
+            break;
+        case RTN_MULTICAST:
+            routes.type = "MULTICAST";
+            break;
+        case RTN_BLACKHOLE:
+            routes.type = "BLACKHOLE";
+            break;
+        case RTN_UNREACHABLE:
+            routes.type = "UNREACHABLE";
+            break;
+        case RTN_PROHIBIT:
+            routes.type = "PROHIBIT";
+            break;
+        case RTN_THROW:
+            routes.type = "THROW";
+            break;
+        case RTN_NAT:
+            routes.type = "NAT";
+            break;
+        case RTN_XRESOLVE:
+            routes.type = "XRESOLVE";
+            break;
+        default:
+            routes.type = "UNKNOWN";
+            break;
+    }
 
-        uint32_t const table = rtnl_route_get_table(route);
-        uint32_t const priority = rtnl_route_get_priority(route);
+    return routes;
+}
+Neigh ShowInfoInterface::neigh_to_info(rtnl_neigh *neigh) {
+    Neigh neigh_json;
 
-        routes.destination = dst_str;
+    char ip_str[INET6_ADDRSTRLEN + 4];
+    neigh_json.ip = format_ip(rtnl_neigh_get_dst(neigh), ip_str, sizeof(ip_str));
 
-        for (int i = 0; i < next_hops; i++) {
-            auto const nh = rtnl_route_nexthop_n(route, i);
-            auto const gateway = rtnl_route_nh_get_gateway(nh);
+    if (auto const lladdr = rtnl_neigh_get_lladdr(neigh)) {
+        char mac_str[20];
+        nl_addr2str(lladdr, mac_str, sizeof(mac_str));
+        neigh_json.mac = mac_str;
+    }
 
-            if (gateway) {
-                char gw_str[100];
-                nl_addr2str(gateway, gw_str, sizeof(gw_str));
-                routes.gateway = gw_str;
-            } else {
-                routes.gateway = "direct";
+    int const state = rtnl_neigh_get_state(neigh);
+    if (state & NUD_INCOMPLETE) {
+        neigh_json.type.emplace_back("INCOMPLETE");
+    }
+    if (state & NUD_REACHABLE) {
+        neigh_json.type.emplace_back("REACHABLE");
+    }
+    if (state & NUD_STALE) {
+        neigh_json.type.emplace_back("STALE");
+    }
+    if (state & NUD_DELAY) {
+        neigh_json.type.emplace_back("DELAY");
+    }
+    if (state & NUD_PROBE) {
+        neigh_json.type.emplace_back("PROBE");
+    }
+    if (state & NUD_FAILED) {
+        neigh_json.type.emplace_back("FAILED");
+    }
+    if (state & NUD_NOARP) {
+        neigh_json.type.emplace_back("NOARP");
+    }
+    if (state & NUD_PERMANENT) {
+        neigh_json.type.emplace_back("PERMANENT");
+    }
+    return neigh_json;
+}
+NeighbourEntry ShowInfoInterface::neigh_to_entry(rtnl_neigh *neigh) {
+    NeighbourEntry entry;
+    entry.ifindex = rtnl_neigh_get_ifindex(neigh);
+    entry.state = static_cast<uint16_t>(rtnl_neigh_get_state(neigh));
+    entry.neigh = neigh_to_info(neigh);
+    try {
+        if (char const *if_name = rtnl_link_get_name(find_link(entry.ifindex))) {
+            entry.interface = if_name;
+        }
+    } catch (exceptions::InterfaceNotFound const &) {
+        // Запись удалённого интерфейса, уведомление о котором ещё не обработано.
+    }
+    return entry;
+}
+int ShowInfoInterface::parse_ip(std::string const &address, unsigned char *bytes) {
+    if (inet_pton(AF_INET, address.c_str(), bytes) == 1) {
+        return AF_INET;
+    }
+    if (inet_pton(AF_INET6, address.c_str(), bytes) == 1) {
+        return AF_INET6;
+    }
+    throw exceptions::InvalidAddress(fmt::format("'{}' не является адресом IPv4 или IPv6", address));
+}
+char *ShowInfoInterface::format_ip(nl_addr *addr, char *buffer, std::size_t const size) {
+    int const family = nl_addr_get_family(addr);
+    unsigned const length = nl_addr_get_len(addr);
+    auto const *const bytes = static_cast<unsigned char const *>(nl_addr_get_binary_addr(addr));
+    char *const end = buffer + size - 1;
+    char *out = buffer;
+
+    if (family == AF_INET && length == 4) {
+        for (unsigned i = 0; i < 4; i++) {
+            if (i > 0) {
+                *out++ = '.';
             }
+            out = std::to_chars(out, end, bytes[i]).ptr;
         }
-
-        routes.metric = priority;
-        routes.table = table;
-
-        switch (rtnl_route_get_type(route)) {
-            case RTN_UNICAST:
-                routes.type = "UNICAST";
-                break;
-            case RTN_LOCAL:
-                routes.type = "LOCAL";
-                break;
-            case RTN_BROADCAST:
-                routes.type = "BROADCAST";
-                break;
-            case RTN_ANYCAST:
-                routes.type = "ANYCAST";
-                break;
-            case RTN_MULTICAST:
-                routes.type = "MULTICAST";
-                break;
-            case RTN_BLACKHOLE:
-                routes.type = "BLACKHOLE";
-                break;
-            case RTN_UNREACHABLE:
-                routes.type = "UNREACHABLE";
-                break;
-            case RTN_PROHIBIT:
-                routes.type = "PROHIBIT";
-                break;
-            case RTN_THROW:
-                routes.type = "THROW";
-                break;
-            case RTN_NAT:
-                routes.type = "NAT";
-                break;
-            case RTN_XRESOLVE:
-                routes.type = "XRESOLVE";
-                break;
-            default:
-                routes.type = "UNKNOWN";
-                break;
+    } else if (family == AF_INET6 && length == 16) {
+        if (inet_ntop(AF_INET6, bytes, buffer, static_cast<socklen_t>(size)) == nullptr) {
+            return nl_addr2str(addr, buffer, size);
         }
+        out = buffer + std::strlen(buffer);
+    } else {
+        return nl_addr2str(addr, buffer, size);
+    }
 
-        m_json.routes.emplace_back(routes);
+    if (unsigned const prefix = nl_addr_get_prefixlen(addr); prefix != length * 8) {
+        *out++ = '/';
+        out = std::to_chars(out, end, prefix).ptr;
     }
+    *out = '\0';
+    return buffer;
 }
 
-void ShowInfoInterface::showInterface(const std::string &interface_name) {
-    int const ifindex = getInterfaceIndex(interface_name);
-
-    showInterfaceByIndex(ifindex);
+void ShowInfoInterface::showInterface(const std::string &interface_name, Section const sections) {
+    showInterfaceByLink(find_link(interface_name), sections);
 }
 
-int ShowInfoInterface::getInterfaceIndex(const std::string &interface_name) const {
-    for (auto obj = nl_cache_get_first(m_link_data.get()); obj; obj = nl_cache_get_next(obj)) {
-        auto const link = reinterpret_cast<struct rtnl_link *>(obj);
+void ShowInfoInterface::showInterfaceByLink(rtnl_link *link, Section const sections) {
+    m_json = {};
 
-        if (char const *if_name = rtnl_link_get_name(link); if_name && interface_name == if_name) {
-            return rtnl_link_get_ifindex(link);
-        }
-    }
+    int const ifindex = rtnl_link_get_ifindex(link);
 
-    throw exceptions::InterfaceNotFound(fmt::format("Интерфейс '{}' не найден", interface_name));
-}
+    print_interface_details(link, sections);
 
-void ShowInfoInterface::showInterfaceByIndex(int ifindex) {
-    rtnl_link *link = nullptr;
-    for (auto obj = nl_cache_get_first(m_link_data.get()); obj; obj = nl_cache_get_next(obj)) {
-        if (auto const current_link = reinterpret_cast<struct rtnl_link *>(obj); rtnl_link_get_ifindex(current_link) == ifindex) {
-            link = current_link;
-            break;
+    // Кэши адресов, соседей и маршрутов не затрагиваются (и не загружаются), если их секции не запрошены.
+    if (has_section(sections, Section::Ip)) {
+        if (m_addr_index_dirty) {
+            rebuild_addr_index();
+        }
+        if (auto const bucket = m_addr_by_link.find(ifindex); bucket != m_addr_by_link.end()) {
+            for (auto const &addr : bucket->second) {
+                print_address_info(addr.get());
+            }
         }
     }
 
-    if (!link) {
-        throw exceptions::InterfaceNotFound(fmt::format("Интерфейс с индексом {} не найден", ifindex));
+    if (has_section(sections, Section::Neigh)) {
+        print_neighbour_info(ifindex);
     }
-
-    print_interface_details(link);
-
-    for (auto addr_obj = nl_cache_get_first(m_addr_data.get()); addr_obj; addr_obj = nl_cache_get_next(addr_obj)) {
-        if (auto const addr = reinterpret_cast<struct rtnl_addr *>(addr_obj); rtnl_addr_get_ifindex(addr) == ifindex) {
-            print_address_info(addr);
-        }
+    if (has_section(sections, Section::Routes)) {
+        print_routes_for_interface(ifindex);
     }
-
-    print_neighbour_info(ifindex);
-    print_routes_for_interface(ifindex);
 }
 
 } // namespace os::network
@@ -4,204 +4,23 @@
 #include <netlink/netlink.h>
 #include <netlink/route/addr.h>
 #include <netlink/route/link.h>
+#include <netlink/route/neighbour.h>
+#include <netlink/route/route.h>
 #include <netlink/socket.h>
 
 #include <iomanip>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "data_source.hpp"
 #include "informer/interface_informer.hpp"
+#include "neighbour_lookup.hpp"
+#include "route_lookup.hpp"
 
 namespace os::network {
 
-/**
- * @struct Packetometr
- * @brief Статистика сетевого трафика интерфейса
- */
-struct Packetometr {
-    uint64_t bytes{};   /**< Количество байт (8 байт) */
-    uint64_t packets{}; /**< Количество пакетов (8 байт) */
-    uint64_t errors{};  /**< Количество ошибок (8 байт) */
-    uint64_t drops{};   /**< Количество отброшенных пакетов (8 байт) */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Packetometr, bytes, packets, errors, drops);
-
-/**
- * @struct Neigh
- * @brief Структура для хранения информации о соседях (ARP/NDP таблица)
- */
-struct Neigh {
-    std::string ip{};                /**< IP-адрес соседа */
-    std::string mac{};               /**< MAC-адрес соседа */
-    std::vector<std::string> type{}; /**< Типы соседей (PERMANENT, REACHABLE и т.д.) */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Neigh, ip, mac, type);
-
-/**
- * @struct Routes
- * @brief Структура для хранения информации о маршрутах
- */
-struct Routes {
-    std::string destination{}; /**< Адрес назначения маршрута */
-    std::string gateway{};     /**< Шлюз для маршрута */
-    std::string type{};        /**< Тип маршрута (UNICAST, LOCAL, BROADCAST и т.д.) */
-    uint32_t metric{};         /**< Метрика маршрута */
-    uint32_t table{};          /**< Таблица маршрутизации */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Routes, destination, gateway, metric, table, type);
-
-/**
- * @struct Ip
- * @brief Структура для хранения информации об IP-адресах интерфейса
- */
-struct Ip {
-    std::string type{};               /**< Тип IP-адреса (IPv4 или IPv6) */
-    std::string ip{};                 /**< IP-адрес с маской подсети */
-    std::string broadcast{};          /**< Широковещательный адрес (для IPv4) */
-    std::string peer{};               /**< Адрес пира (для point-to-point интерфейсов) */
-    std::vector<std::string> flags{}; /**< Флаги IP-адреса (PERMANENT, SECONDARY и т.д.) */
-    int masc{};                       /**< Маска подсети в формате CIDR */
-    uint32_t valid_lft{};             /**< Срок действия адреса (valid lifetime) */
-    uint32_t pref_lft{};              /**< Предпочтительный срок действия (preferred lifetime) */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Ip, type, ip, masc, flags, valid_lft, pref_lft, broadcast, peer);
-
-/**
- * @struct Protocols
- * @brief Структура для хранения информации о поддерживаемых протоколах
- */
-struct Protocols {
-    bool routing_ipv4{}; /**< Поддерживается ли IPv4 маршрутизация */
-    bool multicast{};    /**< Поддерживается ли многоадресная рассылка */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Protocols, routing_ipv4, multicast);
-
-/**
- * @struct OperationalStatus
- * @brief Структура для хранения информации об операционном статусе интерфейса
- */
-struct OperationalStatus {
-    std::string oper_state{}; /**< Операционное состояние интерфейса */
-    std::string link_mode{};  /**< Режим соединения */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(OperationalStatus, oper_state, link_mode);
-
-/**
- * @struct HW
- * @brief Структура для хранения аппаратной информации об интерфейсе
- */
-struct HW {
-    std::string type{};             /**< Тип аппаратного интерфейса (Ethernet, Loopback и т.д.) */
-    std::vector<std::string> mac{}; /**< MAC-адрес(а) интерфейса */
-    uint64_t mtu{};                 /**< Максимальный размер передаваемого блока (MTU) */
-    uint64_t size_queue{};          /**< Размер очереди передачи (txqlen) */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(HW, type, mac, mtu, size_queue);
-
-/**
- * @struct General
- * @brief Структура для хранения общей информации об интерфейсе
- */
-struct General {
-    std::string state{};              /**< Состояние интерфейса (UP/DOWN) */
-    std::string type{};               /**< Тип интерфейса (BROADCAST, LOOPBACK и т.д.) */
-    std::vector<std::string> flags{}; /**< Флаги интерфейса */
-    int index{};                      /**< Индекс интерфейса */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(General, index, state, type, flags);
-
-/**
- * @struct Json
- * @brief Структура для формирования полного JSON-ответа с информацией об интерфейсе
- */
-struct Json {
-    General general{};                      /**< Общая информация об интерфейсе (96 байт)*/
-    HW hw{};                                /**< Аппаратная информация (72 байт) */
-    OperationalStatus operational_status{}; /**< Операционный статус (64 байт) */
-    std::string interface{};                /**< Имя интерфейса (32 байт) */
-    Packetometr tx{};                       /**< Статистика отправки (32 байт) */
-    Packetometr rx{};                       /**< Статистика приёма (32 байт) */
-    std::vector<Ip> ip{};                   /**< Список IP-адресов (24 байт) */
-    std::vector<Routes> routes{};           /**< Список маршрутов (24 байт) */
-    std::vector<Neigh> neigh{};             /**< Список соседей (ARP/NDP) (24 байт) */
-    Protocols protocols{};                  /**< Поддерживаемые протоколы (2 байт) */
-};
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Json, interface, general, hw, operational_status, protocols, ip, routes, neigh, tx, rx);
-
-namespace exceptions {
-/**
- * @struct NetlinkEx
- * @brief Базовое исключение для ошибок Netlink
- */
-struct NetlinkEx : std::runtime_error {
-    using std::runtime_error::runtime_error;
-};
-
-/**
- * @struct AllocateSocket
- * @brief Исключение при невозможности выделить сокет Netlink
- */
-struct AllocateSocket final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct ConnectNetlinkRoute
- * @brief Исключение при ошибке подключения к NETLINK_ROUTE
- */
-struct ConnectNetlinkRoute final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct GetDataLinks
- * @brief Исключение при ошибке получения данных о сетевых интерфейсах
- */
-struct GetDataLinks final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct GetDataAddr
- * @brief Исключение при ошибке получения данных об IP-адресах
- */
-struct GetDataAddr final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct GetDataRoute
- * @brief Исключение при ошибке получения данных о маршрутах
- */
-struct GetDataRoute final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct GetDataNeigh
- * @brief Исключение при ошибке получения данных о соседях
- */
-struct GetDataNeigh final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct InterfaceNotFound
- * @brief Исключение, когда запрошенный интерфейс не найден
- */
-struct InterfaceNotFound final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-
-/**
- * @struct InterfaceOperationEx
- * @brief Исключение при ошибке операции с интерфейсом (включение/выключение)
- */
-struct InterfaceOperationEx final : NetlinkEx {
-    using NetlinkEx::NetlinkEx;
-};
-} // namespace exceptions
-
 /**
  * @class ShowInfoInterface
  * @brief Класс для получения детальной информации о сетевых интерфейсах
@@ -211,17 +30,25 @@ struct InterfaceOperationEx final : NetlinkEx {
  * в текущем пространстве имен.
  */
 class ShowInfoInterface final : public InformerNetlink {
+    using LinkPtr = std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)>;
+    using AddrPtr = std::unique_ptr<rtnl_addr, decltype(&rtnl_addr_put)>;
+    using RoutePtr = std::unique_ptr<rtnl_route, decltype(&rtnl_route_put)>;
+    using NeighPtr = std::unique_ptr<rtnl_neigh, decltype(&rtnl_neigh_put)>;
+
    public:
     /**
-     * @brief Конструктор, инициализирующий соединение с Netlink и загружающий кэши данных
-     * @throw exceptions::AllocateSocket если не удалось выделить сокет Netlink
-     * @throw exceptions::ConnectNetlinkRoute если не удалось подключиться к NETLINK_ROUTE
+     * @brief Конструктор, загружающий кэши данных из источника
+     * @param options Параметры создания (способ обновления кэшей, предзагружаемые кэши)
+     * @param data_source Источник данных (NetlinkDataSource или ReplayDataSource)
      * @throw exceptions::GetDataLinks если не удалось получить данные о сетевых интерфейсах
      * @throw exceptions::GetDataAddr если не удалось получить данные об IP-адресах
      * @throw exceptions::GetDataRoute если не удалось получить данные о маршрутах
      * @throw exceptions::GetDataNeigh если не удалось получить данные о соседях
+     * @throw exceptions::CacheManager если не удалось подписаться на уведомления (режим UpdateMode::Events),
+     *        источник данных не подключён к ядру или задано ограничение дампа
+     * @throw exceptions::InterfaceNotFound если интерфейс ограничения дампа не найден
      */
-    ShowInfoInterface();
+    ShowInfoInterface(InformerOptions const &options, std::unique_ptr<DataSource> data_source);
     ~ShowInfoInterface() override = default;
 
     ShowInfoInterface(ShowInfoInterface const &) = delete;
@@ -244,30 +71,352 @@ class ShowInfoInterface final : public InformerNetlink {
      * @throw exceptions::InterfaceNotFound если интерфейс не найден.
      */
     void disable_interface(std::string const &interface_name) override;
+    /**
+     * @brief Изменяет административное состояние нескольких интерфейсов пачками запросов
+     * @param changes Изменения
+     * @return Результаты в порядке changes
+     * @throw exceptions::InterfaceOperationEx если не удалось отправить запросы или получить подтверждения
+     */
+    std::vector<InterfaceChangeResult> set_interfaces_state(std::vector<InterfaceStateChange> const &changes) override;
     /**
      * @brief Получает информацию об указанном интерфейсе
      * @param interface_name Имя интерфейса
+     * @param sections Маска секций, включаемых в ответ
      * @return JSON с информацией об интерфейсе или сообщением об ошибке
      */
-    ::nlohmann::json get_interface_info(std::string const &interface_name) override;
+    ::nlohmann::json get_interface_info(std::string const &interface_name, Section sections = Section::All) override;
     /**
      * @brief Получает список всех доступных интерфейсов
      * @return JSON со списком имен интерфейсов
      */
     ::nlohmann::json get_all_interfaces() override;
+    /**
+     * @brief Получает подробную информацию обо всех интерфейсах за один проход по каждому кэшу
+     * @param sections Маска секций, включаемых в ответ
+     * @return JSON со списком объектов, аналогичных результату get_interface_info
+     */
+    ::nlohmann::json get_all_interfaces_info(Section sections = Section::All) override;
+    /**
+     * @brief Получает подробную информацию об интерфейсах из списка
+     * @param interface_names Имена интерфейсов
+     * @param sections Маска секций, включаемых в ответ
+     * @return JSON со списком объектов в порядке имён (для ненайденных - объект с ошибкой)
+     */
+    ::nlohmann::json get_interfaces_info(std::vector<std::string> const &interface_names, Section sections = Section::All) override;
+    /**
+     * @brief Получает информацию об интерфейсе в виде структуры
+     * @param interface_name Имя интерфейса
+     * @param sections Маска заполняемых секций
+     * @return Структура с информацией об интерфейсе
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     */
+    Json get_interface_data(std::string const &interface_name, Section sections = Section::All) override;
+    /**
+     * @brief Получает информацию обо всех интерфейсах в виде структур
+     * @param sections Маска заполняемых секций
+     * @return Структуры в порядке кэша интерфейсов
+     */
+    std::vector<Json> get_all_interfaces_data(Section sections = Section::All) override;
+    /**
+     * @brief Получает информацию об интерфейсах из списка в виде структур
+     * @param interface_names Имена интерфейсов
+     * @param sections Маска заполняемых секций
+     * @return Структуры в порядке имён
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     */
+    std::vector<Json> get_interfaces_data(std::vector<std::string> const &interface_names, Section sections = Section::All) override;
+    /**
+     * @brief Возвращает дескриптор сокета уведомлений менеджера кэшей
+     * @return Дескриптор в режиме UpdateMode::Events, иначе -1
+     */
+    [[nodiscard]] int get_event_fd() const override;
+    /**
+     * @brief Находит маршрут для адреса по наибольшему совпадению префикса
+     * @param address Адрес IPv4 или IPv6
+     * @param table Таблица маршрутизации (0 - local, main, default)
+     * @return Найденный маршрут или std::nullopt
+     * @throw exceptions::InvalidAddress если адрес не разобран
+     */
+    std::optional<RouteMatch> lookup_route(std::string const &address, uint32_t table = 0) override;
+    /**
+     * @brief Находит запись ARP/NDP по интерфейсу и IP-адресу через хеш-индекс
+     * @param interface_name Имя интерфейса
+     * @param address Адрес IPv4 или IPv6
+     * @return Найденная запись или std::nullopt
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     * @throw exceptions::InvalidAddress если адрес не разобран
+     */
+    std::optional<NeighbourEntry> get_neighbour(std::string const &interface_name, std::string const &address) override;
+    /**
+     * @brief Выполняет выборочный дамп таблиц ARP/NDP
+     * @param filter Условия выборки
+     * @return Подходящие записи
+     * @throw exceptions::InterfaceNotFound если интерфейс фильтра не найден
+     * @throw exceptions::GetDataNeigh если не удалось выполнить дамп
+     */
+    std::vector<NeighbourEntry> get_neighbours(NeighbourFilter const &filter) override;
+    /**
+     * @brief Применяет уведомления ядра или перезагружает кэши полным дампом
+     * @param timeout_ms Максимальное время ожидания уведомлений
+     * @return Количество обработанных уведомлений или перезагруженных кэшей
+     * @throw exceptions::InterfaceOperationEx если обновление не удалось
+     */
+    int refresh(int timeout_ms) override;
+    /**
+     * @brief Загружает или перезагружает указанные кэши полным дампом
+     * @param caches Битовая маска кэшей
+     */
+    void load_caches(Cache caches) override;
+    /**
+     * @brief Подписывается на события, строящиеся из уведомлений менеджера кэшей
+     *
+     * Исключения обработчика перехватываются в dispatch_events и отбрасываются.
+     * @param events Маска событий
+     * @param callback Обработчик событий
+     * @return Идентификатор подписки
+     * @throw exceptions::InterfaceOperationEx если экземпляр создан не в режиме UpdateMode::Events
+     */
+    int subscribe(Event events, InterfaceEventCallback callback) override;
+    /**
+     * @brief Отменяет подписку
+     * @param subscription Идентификатор подписки
+     */
+    void unsubscribe(int subscription) override;
 
    private:
+    /**
+     * @struct PendingChanges
+     * @brief Запросы пакетной операции, ожидающие подтверждения ядра
+     */
+    struct PendingChanges {
+        std::unordered_map<uint32_t, std::size_t> by_seq{};   /**< Позиция в results по порядковому номеру сообщения */
+        std::vector<InterfaceChangeResult> *results{nullptr}; /**< Результаты пакетной операции */
+    };
+
+    /**
+     * @struct NeighbourDump
+     * @brief Состояние выборочного дампа соседей
+     */
+    struct NeighbourDump {
+        ShowInfoInterface *self{nullptr};              /**< Экземпляр, выполняющий дамп */
+        NeighbourFilter const *filter{nullptr};        /**< Условия выборки */
+        int ifindex{};                                 /**< Индекс интерфейса фильтра (0 - все) */
+        std::vector<NeighbourEntry> *entries{nullptr}; /**< Подходящие записи */
+    };
+
+    /**
+     * @struct Subscription
+     * @brief Подписка на события
+     */
+    struct Subscription {
+        int id{};                          /**< Идентификатор */
+        Event events{Event::None};         /**< Маска событий */
+        InterfaceEventCallback callback{}; /**< Обработчик */
+    };
+
+    /**
+     * @brief Возвращает владеющий указатель на кэш указанного вида
+     * @param kind Вид кэша (один бит маски Cache)
+     * @return Ссылка на член класса, хранящий кэш
+     */
+    std::unique_ptr<nl_cache, decltype(&nl_cache_free)> &cache_slot(Cache kind);
+    /**
+     * @brief Помечает индексы, построенные по кэшу указанного вида, устаревшими
+     * @param kind Вид кэша (один бит маски Cache)
+     */
+    void mark_index_dirty(Cache kind);
+    /**
+     * @brief Загружает кэш указанного вида или перезагружает уже загруженный
+     *
+     * В режиме UpdateMode::Events новый кэш передаётся менеджеру, который выполняет начальный дамп
+     * и далее применяет уведомления ядра.
+     * @param kind Вид кэша (один бит маски Cache)
+     * @throw exceptions::GetDataLinks, exceptions::GetDataAddr, exceptions::GetDataRoute, exceptions::GetDataNeigh
+     *        если не удалось получить данные
+     * @throw exceptions::CacheManager если не удалось подписать кэш на уведомления
+     */
+    void load_cache(Cache kind);
+    /**
+     * @brief Строит условия дампа кэша по ограничению из параметров создания
+     * @param kind Вид кэша (один бит маски Cache)
+     * @return Условия (пустые для кэшей интерфейсов и соседей)
+     * @throw exceptions::InterfaceNotFound если интерфейс ограничения не найден
+     */
+    DumpFilter dump_filter(Cache kind);
+    /**
+     * @brief Удаляет из кэша объекты, не подходящие под условия дампа
+     *
+     * Нужно, если ядро не поддерживает строгую проверку запросов или кэш заполнен из записанного дампа.
+     * @param kind Вид кэша (Cache::Addr или Cache::Route)
+     * @param cache Кэш
+     * @param filter Условия дампа
+     */
+    static void discard_out_of_scope(Cache kind, nl_cache *cache, DumpFilter const &filter);
+    /**
+     * @brief Проверяет, что объект построен из полного описания интерфейса (RTM_NEWLINK с AF_UNSPEC)
+     *
+     * Уведомления AF_INET6 и AF_BRIDGE несут только часть атрибутов. Семейство объекта признаком не служит:
+     * libnl назначает интерфейсам вида bridge семейство AF_BRIDGE, поэтому проверяется атрибут
+     * IFLA_NUM_TX_QUEUES, который ядро передаёт только в полном описании.
+     * @param link Объект интерфейса
+     * @return true, если объект описывает интерфейс целиком
+     */
+    static bool is_device_link(rtnl_link *link);
+    /**
+     * @brief Возвращает сокет для запросов изменения интерфейсов
+     * @return Подключенный сокет NETLINK_ROUTE
+     * @throw exceptions::InterfaceOperationEx если источник данных доступен только для чтения
+     */
+    nl_sock *control_socket() const;
+    /**
+     * @brief Возвращает кэш указанного вида, загружая его при первом обращении
+     * @param kind Вид кэша (один бит маски Cache)
+     * @return Указатель на кэш
+     */
+    nl_cache *get_cache(Cache kind);
+    /**
+     * @brief Приводит кэш интерфейсов в актуальное состояние после изменения интерфейса
+     */
+    void sync_link_cache();
+    /**
+     * @brief Перезагружает полным дампом все загруженные кэши
+     *
+     * В режиме UpdateMode::Events вызывается после ошибки менеджера кэшей: менеджер прерывает разбор
+     * прочитанных уведомлений на первой ошибке, и остальные изменения в кэши не попадают.
+     * @return Число перезагруженных кэшей
+     * @throw exceptions::InterfaceOperationEx если перезагрузка не удалась
+     */
+    int reload_caches();
+    /**
+     * @brief Перестраивает индексы интерфейсов по имени и по индексу за один проход по кэшу
+     */
+    void rebuild_link_index();
+    /**
+     * @brief Находит интерфейс по имени через хеш-индекс
+     * @param interface_name Имя интерфейса
+     * @return Указатель на объект интерфейса (действителен до следующего обновления кэша)
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     */
+    rtnl_link *find_link(std::string const &interface_name);
+    /**
+     * @brief Находит интерфейс по индексу через хеш-индекс
+     * @param ifindex Индекс интерфейса
+     * @return Указатель на объект интерфейса (действителен до следующего обновления кэша)
+     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     */
+    rtnl_link *find_link(int ifindex);
+    /**
+     * @brief Группирует IP-адреса по индексу интерфейса за один проход по кэшу
+     */
+    void rebuild_addr_index();
+    /**
+     * @brief Группирует маршруты по индексам интерфейсов их nexthop за один проход по кэшу
+     */
+    void rebuild_route_index();
+    /**
+     * @brief Строит индекс поиска маршрутов по префиксу за один проход по кэшу
+     */
+    void rebuild_route_lookup();
+    /**
+     * @brief Группирует записи ARP/NDP по индексу интерфейса за один проход по кэшу
+     */
+    void rebuild_neigh_index();
+    /**
+     * @brief Строит хеш-индекс записей ARP/NDP по (ifindex, IP) за один проход по кэшу
+     */
+    void rebuild_neigh_lookup();
+    /**
+     * @brief Обработчик сообщения выборочного дампа соседей
+     *
+     * Интерфейс, семейство и состояние проверяются по заголовку ndmsg, поэтому объект rtnl_neigh
+     * строится только для подходящих записей.
+     * @param msg Сообщение RTM_NEWNEIGH
+     * @param data Указатель на NeighbourDump
+     * @return NL_OK
+     */
+    static int on_neighbour_message(nl_msg *msg, void *data);
+    /**
+     * @brief Обработчик уведомлений менеджера кэшей, помечающий индексы изменённого кэша устаревшими
+     * @param cache Кэш, в котором произошло изменение
+     * @param old_obj Предыдущее состояние объекта (может быть nullptr)
+     * @param new_obj Новое состояние объекта (может быть nullptr)
+     * @param action Тип изменения (NL_ACT_NEW, NL_ACT_DEL, NL_ACT_CHANGE)
+     * @param data Указатель на экземпляр ShowInfoInterface
+     */
+    static void on_cache_change(nl_cache *cache, nl_object *old_obj, nl_object *new_obj, uint64_t, int action, void *data);
+    /**
+     * @brief Перезагружает кэш маршрутов, если ядро могло удалить маршруты без уведомлений
+     * @throw exceptions::InterfaceOperationEx если перезагрузка не удалась
+     */
+    void resync_stale_routes();
+    /**
+     * @brief Строит события по изменению объекта кэша и ставит их в очередь доставки
+     * @param kind Вид кэша (один бит маски Cache)
+     * @param old_obj Предыдущее состояние объекта (может быть nullptr)
+     * @param new_obj Новое состояние объекта (может быть nullptr)
+     * @param action Тип изменения (NL_ACT_NEW, NL_ACT_DEL, NL_ACT_CHANGE)
+     */
+    void record_events(Cache kind, nl_object *old_obj, nl_object *new_obj, int action);
+    /**
+     * @brief Ставит событие в очередь доставки, если на него есть подписка
+     * @param event Событие
+     */
+    void push_event(InterfaceEvent &&event);
+    /**
+     * @brief Доставляет накопившиеся события подписчикам; исключения обработчиков отбрасываются
+     */
+    void dispatch_events();
+    /**
+     * @brief Отправляет пачку запросов изменения одним системным вызовом и ожидает подтверждения всех запросов
+     *
+     * Запросы, подтверждения которых не получены за M_ACK_TIMEOUT_MS, завершаются ошибкой ETIMEDOUT,
+     * а при переполнении приёмного буфера - ENOBUFS.
+     * @param buffer Сообщения Netlink, записанные подряд
+     * @param pending Ожидающие подтверждения запросы пачки
+     * @throw exceptions::InterfaceOperationEx если не удалось отправить запросы
+     */
+    void send_change_batch(std::vector<char> const &buffer, PendingChanges &pending);
+    /**
+     * @brief Завершает ошибкой все запросы пачки, ожидающие подтверждения
+     * @param pending Ожидающие подтверждения запросы пачки
+     * @param error Код ошибки errno
+     * @param reason Описание причины
+     */
+    static void fail_pending_changes(PendingChanges &pending, int error, std::string const &reason);
+    /**
+     * @brief Обработчик подтверждения (NLMSG_ERROR с нулевым кодом) запроса пакетной операции
+     * @param msg Сообщение подтверждения
+     * @param data Указатель на PendingChanges
+     * @return NL_OK
+     */
+    static int on_change_ack(nl_msg *msg, void *data);
+    /**
+     * @brief Обработчик ошибки ядра для запроса пакетной операции
+     * @param error Сообщение об ошибке с заголовком исходного запроса
+     * @param data Указатель на PendingChanges
+     * @return NL_SKIP (продолжить обработку остальных подтверждений)
+     */
+    static int on_change_error(sockaddr_nl *, nlmsgerr *error, void *data);
+
     /**
      * @brief Преобразует числовой код типа оборудования в читаемую строку
      * @param type Код типа оборудования (из linux/if_arp.h)
      * @return Строковое представление типа оборудования
      */
     static std::string arp_hrd_type_to_string(unsigned int type);
+    /**
+     * @brief Формирует JSON только из запрошенных секций
+     * @param json Заполненная структура с информацией об интерфейсе
+     * @param sections Маска секций
+     * @return JSON-объект с полем "interface" и запрошенными секциями
+     */
+    static ::nlohmann::json project_json(Json const &json, Section sections);
     /**
      * @brief Извлекает и сохраняет основную информацию об интерфейсе
      * @param link Указатель на структуру интерфейса Netlink
+     * @param sections Маска секций, которые нужно заполнить
      */
-    void print_interface_details(rtnl_link *link);
+    void print_interface_details(rtnl_link *link, Section sections);
     /**
      * @brief Извлекает и сохраняет информацию об IP-адресе
      * @param addr Указатель на структуру адреса Netlink
@@ -283,35 +432,110 @@ class ShowInfoInterface final : public InformerNetlink {
      * @param ifindex Индекс интерфейса
      */
     void print_routes_for_interface(int ifindex);
+    /**
+     * @brief Преобразует маршрут в структуру секции routes
+     * @param route Указатель на структуру маршрута Netlink
+     * @return Структура с информацией о маршруте (шлюз - последнего nexthop)
+     */
+    static Routes route_to_info(rtnl_route *route);
+    /**
+     * @brief Преобразует запись ARP/NDP в структуру секции neigh
+     * @param neigh Указатель на структуру соседа Netlink (с адресом назначения)
+     * @return Структура с адресами и состояниями записи
+     */
+    static Neigh neigh_to_info(rtnl_neigh *neigh);
+    /**
+     * @brief Дополняет запись ARP/NDP интерфейсом и состоянием
+     * @param neigh Указатель на структуру соседа Netlink (с адресом назначения)
+     * @return Запись с именем интерфейса (пустым, если интерфейс уже удалён)
+     */
+    NeighbourEntry neigh_to_entry(rtnl_neigh *neigh);
+    /**
+     * @brief Разбирает текстовый адрес IPv4 или IPv6
+     * @param address Адрес
+     * @param bytes Буфер (16 байт) для адреса в сетевом порядке байт
+     * @return AF_INET или AF_INET6
+     * @throw exceptions::InvalidAddress если адрес не разобран
+     */
+    static int parse_ip(std::string const &address, unsigned char *bytes);
+    /**
+     * @brief Форматирует IP-адрес в том же виде, что и nl_addr2str, без snprintf
+     *
+     * Маршрут форматируется при каждом поиске lookup_route, а nl_addr2str собирает строку через
+     * snprintf и strncat и стоит сотни наносекунд. Адреса других семейств передаются nl_addr2str.
+     * @param addr Адрес (с длиной префикса, если она меньше длины адреса)
+     * @param buffer Буфер (не меньше INET6_ADDRSTRLEN + 4 байт)
+     * @param size Размер буфера
+     * @return buffer
+     */
+    static char *format_ip(nl_addr *addr, char *buffer, std::size_t size);
 
     /**
      * @brief Показывает информацию только для указанного интерфейса
      * @param interface_name Имя интерфейса
+     * @param sections Маска секций, которые нужно заполнить
      * @throw exceptions::InterfaceNotFound если интерфейс не найден
      */
-    void showInterface(const std::string &interface_name);
+    void showInterface(const std::string &interface_name, Section sections);
 
     /**
-     * @brief Получает индекс интерфейса по его имени
-     * @param interface_name Имя интерфейса
-     * @return Индекс интерфейса
-     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     * @brief Показывает детальную информацию об интерфейсе по объекту из кэша
+     * @param link Указатель на структуру интерфейса Netlink
+     * @param sections Маска секций, которые нужно заполнить
      */
-    [[nodiscard]] int getInterfaceIndex(const std::string &interface_name) const;
+    void showInterfaceByLink(rtnl_link *link, Section sections);
 
     /**
-     * @brief Показывает детальную информацию о конкретном интерфейсе по его индексу
-     * @param ifindex Индекс интерфейса
-     * @throw exceptions::InterfaceNotFound если интерфейс не найден
+     * @brief Максимальное количество запросов пакетной операции в одном системном вызове
+     *
+     * Каждое подтверждение ядро отправляет отдельной датаграммой и учитывает в SO_RCVBUF полный размер
+     * её буфера (skb), а не длину сообщения. Подтверждение, не поместившееся в буфер, отбрасывается,
+     * поэтому размер пачки ограничивает буфер сокета управления (см. M_ACK_BUFFER_BYTES).
+     */
+    static constexpr std::size_t M_CHANGE_BATCH_SIZE = 32;
+    /**
+     * @brief Приблизительный объём приёмного буфера, занимаемый одним подтверждением
+     */
+    static constexpr int M_ACK_BUFFER_BYTES = 2048;
+    /**
+     * @brief Максимальное время ожидания подтверждений одной пачки запросов, мс
+     */
+    static constexpr int M_ACK_TIMEOUT_MS = 5000;
+    /**
+     * @brief Запрашиваемый размер приёмного буфера сокета уведомлений менеджера кэшей
+     *
+     * libnl по умолчанию устанавливает 32 КиБ, и создание моста с портами переполняет такой буфер.
+     * Ядро ограничивает значение параметром net.core.rmem_max.
      */
-    void showInterfaceByIndex(int ifindex);
+    static constexpr int M_EVENT_BUFFER_BYTES = 1 << 20;
 
     Json m_json{}; /**< Структура JSON для хранения информации об интерфейсе */
-    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> m_netlink_socket{nullptr, nl_socket_free}; /**< Сокет Netlink */
+    UpdateMode m_update_mode{UpdateMode::Snapshot}; /**< Способ обновления кэшей */
+    DumpScope m_scope{};                            /**< Ограничение дампов маршрутов и адресов */
+    bool m_routes_stale{false}; /**< Кэш маршрутов требует перезагрузки (интерфейс выключен или удалён) */
+    std::unique_ptr<DataSource> m_data_source{};                                                   /**< Источник данных кэшей */
     std::unique_ptr<nl_cache, decltype(&nl_cache_free)> m_link_data{nullptr, nl_cache_free};       /**< Кэш данных об интерфейсах */
     std::unique_ptr<nl_cache, decltype(&nl_cache_free)> m_addr_data{nullptr, nl_cache_free};       /**< Кэш данных об IP-адресах */
     std::unique_ptr<nl_cache, decltype(&nl_cache_free)> m_route_data{nullptr, nl_cache_free};      /**< Кэш данных о маршрутах */
     std::unique_ptr<nl_cache, decltype(&nl_cache_free)> m_neigh_data{nullptr, nl_cache_free};      /**< Кэш данных о соседях */
+    std::unordered_map<int, LinkPtr> m_links_by_index{};                                           /**< Индекс интерфейсов по ifindex */
+    std::unordered_map<std::string, rtnl_link *> m_links_by_name{};                                /**< Индекс интерфейсов по имени */
+    bool m_link_index_dirty{true};                                                                 /**< Индексы требуют перестроения */
+    std::unordered_map<int, std::vector<AddrPtr>> m_addr_by_link{};                                /**< IP-адреса по ifindex */
+    std::unordered_map<int, std::vector<RoutePtr>> m_routes_by_link{};                             /**< Маршруты по ifindex nexthop */
+    std::unordered_map<int, std::vector<NeighPtr>> m_neigh_by_link{};                              /**< Соседи по ifindex */
+    bool m_addr_index_dirty{true};                                                                 /**< Группировка адресов устарела */
+    bool m_route_index_dirty{true};                                                                /**< Группировка маршрутов устарела */
+    RouteLookupTable m_route_lookup{};                                                             /**< Индекс маршрутов по префиксу назначения */
+    bool m_route_lookup_dirty{true};                                                               /**< Индекс по префиксу требует перестроения */
+    bool m_neigh_index_dirty{true};                                                                /**< Группировка соседей устарела */
+    NeighbourLookupTable m_neigh_lookup{};                                                         /**< Индекс соседей по (ifindex, IP) */
+    bool m_neigh_lookup_dirty{true};                                                               /**< Индекс соседей требует перестроения */
+    std::unique_ptr<nl_cache_mngr, decltype(&nl_cache_mngr_free)> m_cache_manager{nullptr, nl_cache_mngr_free}; /**< Менеджер кэшей (UpdateMode::Events) */
+    std::vector<Subscription> m_subscriptions{}; /**< Подписки на события */
+    Event m_subscribed_events{Event::None};      /**< Объединение масок всех подписок */
+    int m_next_subscription{1};                  /**< Идентификатор следующей подписки */
+    std::vector<InterfaceEvent> m_events{};      /**< События, ожидающие доставки */
 };
 
 } // namespace os::network
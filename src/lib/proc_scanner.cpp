@@ -0,0 +1,159 @@
+#include "proc_scanner.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+namespace os::network {
+
+ProcNamespaceScanner *ProcNamespaceScanner::create(ScannerOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new ProcfsNamespaceScanner(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+ProcfsNamespaceScanner::ProcfsNamespaceScanner(ScannerOptions const &options)
+    : m_proc_root{options.proc_root},
+      m_workers{options.workers != 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency())} {}
+
+std::vector<ProcNamespace> ProcfsNamespaceScanner::scan(bool const full) {
+    std::lock_guard const lock(m_mutex);
+
+    auto pids = list_pids();
+    std::sort(pids.begin(), pids.end());
+
+    // Завершившиеся процессы (и при полном сканировании - все известные) удаляются из таблиц.
+    std::vector<int> gone;
+    for (auto const &[pid, inode] : m_pid_inode) {
+        if (full || !std::binary_search(pids.begin(), pids.end(), pid)) {
+            gone.push_back(pid);
+        }
+    }
+    for (int const pid : gone) {
+        forget(pid);
+    }
+
+    std::erase_if(pids, [this](int const pid) { return m_pid_inode.contains(pid); });
+
+    std::set<uint64_t> added;
+    for (auto const &[pid, inode] : resolve(pids)) {
+        m_pid_inode.emplace(pid, inode);
+        if (inode != 0) {
+            m_namespaces[inode].pids.insert(pid);
+            added.insert(inode);
+        }
+    }
+    for (uint64_t const inode : added) {
+        Entry &entry = m_namespaces[inode];
+        if (!entry.handle) {
+            entry.handle = open_handle(inode, entry.pids);
+        }
+    }
+
+    std::vector<ProcNamespace> result;
+    result.reserve(m_namespaces.size());
+    for (auto const &[inode, entry] : m_namespaces) {
+        result.push_back({inode, {entry.pids.begin(), entry.pids.end()}, entry.handle});
+    }
+    return result;
+}
+
+std::vector<int> ProcfsNamespaceScanner::list_pids() const {
+    DIR *const dir = opendir(m_proc_root.c_str());
+    if (dir == nullptr) {
+        throw exceptions::ProcScanEx(::fmt::format("Open {}: {}", m_proc_root, std::strerror(errno)));
+    }
+
+    std::vector<int> pids;
+    dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr) {
+        int pid = 0;
+        char const *const end = entry->d_name + std::strlen(entry->d_name);
+        if (auto const [ptr, ec] = std::from_chars(entry->d_name, end, pid); ec == std::errc{} && ptr == end) {
+            pids.push_back(pid);
+        }
+    }
+    closedir(dir);
+    return pids;
+}
+
+std::vector<std::pair<int, uint64_t>> ProcfsNamespaceScanner::resolve(std::vector<int> const &pids) const {
+    std::vector<std::pair<int, uint64_t>> result(pids.size());
+
+    auto const worker = [&](std::size_t const begin, std::size_t const end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            result[i] = {pids[i], resolve_one(pids[i])};
+        }
+    };
+
+    std::size_t const workers = pids.size() < M_PARALLEL_THRESHOLD ? 1 : std::min(m_workers, pids.size() / M_PARALLEL_THRESHOLD + 1);
+    if (workers == 1) {
+        worker(0, pids.size());
+        return result;
+    }
+
+    // stat() по /proc/<pid>/ns/net не требует общих данных, поэтому список просто делится на равные части.
+    std::vector<std::jthread> threads;
+    threads.reserve(workers);
+    std::size_t const chunk = (pids.size() + workers - 1) / workers;
+    for (std::size_t begin = 0; begin < pids.size(); begin += chunk) {
+        threads.emplace_back(worker, begin, std::min(begin + chunk, pids.size()));
+    }
+    threads.clear();
+    return result;
+}
+
+uint64_t ProcfsNamespaceScanner::resolve_one(int const pid) const {
+    struct stat st{};
+    if (::stat(::fmt::format("{}/{}/ns/net", m_proc_root, pid).c_str(), &st) != 0) {
+        return 0;
+    }
+    return st.st_ino;
+}
+
+std::shared_ptr<NetNamespaceHandle const> ProcfsNamespaceScanner::open_handle(uint64_t const inode, std::set<int> const &pids) const {
+    for (int const pid : pids) {
+        int const fd = ::open(::fmt::format("{}/{}/ns/net", m_proc_root, pid).c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+
+        // Между stat() и open() процесс мог завершиться, а PID - достаться другому процессу.
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_ino != inode) {
+            ::close(fd);
+            continue;
+        }
+        return std::make_shared<NetNamespaceHandle const>(fd, st.st_dev, inode);
+    }
+    return nullptr;
+}
+
+void ProcfsNamespaceScanner::forget(int const pid) {
+    auto const it = m_pid_inode.find(pid);
+    if (it == m_pid_inode.end()) {
+        return;
+    }
+
+    if (auto const ns = m_namespaces.find(it->second); ns != m_namespaces.end()) {
+        ns->second.pids.erase(pid);
+        if (ns->second.pids.empty()) {
+            m_namespaces.erase(ns);
+        }
+    }
+    m_pid_inode.erase(it);
+}
+
+} // namespace os::network
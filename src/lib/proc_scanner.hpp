@@ -0,0 +1,99 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "informer/proc_namespace_scanner.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct ProcScanEx
+ * @brief Исключение при ошибке чтения procfs
+ */
+struct ProcScanEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @class ProcfsNamespaceScanner
+ * @brief Реализация ProcNamespaceScanner, проверяющая новые процессы параллельно
+ */
+class ProcfsNamespaceScanner final : public ProcNamespaceScanner {
+   public:
+    /**
+     * @brief Конструктор
+     * @param options Параметры сканера
+     */
+    explicit ProcfsNamespaceScanner(ScannerOptions const &options);
+    ~ProcfsNamespaceScanner() override = default;
+
+    ProcfsNamespaceScanner(ProcfsNamespaceScanner const &) = delete;
+    ProcfsNamespaceScanner(ProcfsNamespaceScanner &&) = delete;
+    ProcfsNamespaceScanner &operator=(ProcfsNamespaceScanner const &) = delete;
+    ProcfsNamespaceScanner &operator=(ProcfsNamespaceScanner &&) = delete;
+
+    std::vector<ProcNamespace> scan(bool full = false) override;
+
+   private:
+    /**
+     * @struct Entry
+     * @brief Процессы и дескриптор одного пространства имен
+     */
+    struct Entry {
+        std::set<int> pids{};                               /**< Процессы пространства имен */
+        std::shared_ptr<NetNamespaceHandle const> handle{}; /**< Открытый дескриптор */
+    };
+
+    /**
+     * @brief Перечисляет процессы в каталоге procfs
+     * @return Идентификаторы процессов
+     * @throw exceptions::ProcScanEx если каталог не удалось открыть
+     */
+    [[nodiscard]] std::vector<int> list_pids() const;
+    /**
+     * @brief Определяет inode пространства имен процессов, распределяя проверку по потокам
+     * @param pids Идентификаторы процессов
+     * @return Пары (pid, inode); 0 - процесс завершился или доступ запрещён
+     */
+    [[nodiscard]] std::vector<std::pair<int, uint64_t>> resolve(std::vector<int> const &pids) const;
+    /**
+     * @brief Определяет inode пространства имен одного процесса
+     * @param pid Идентификатор процесса
+     * @return Номер inode или 0
+     */
+    [[nodiscard]] uint64_t resolve_one(int pid) const;
+    /**
+     * @brief Открывает дескриптор пространства имен через любой из его процессов
+     * @param inode Ожидаемый номер inode
+     * @param pids Процессы пространства имен
+     * @return Дескриптор или nullptr
+     */
+    [[nodiscard]] std::shared_ptr<NetNamespaceHandle const> open_handle(uint64_t inode, std::set<int> const &pids) const;
+    /**
+     * @brief Удаляет процесс из таблиц
+     * @param pid Идентификатор процесса
+     */
+    void forget(int pid);
+
+    /**
+     * @brief Количество новых процессов, начиная с которого проверка распределяется по потокам
+     */
+    static constexpr std::size_t M_PARALLEL_THRESHOLD = 512;
+
+    std::string m_proc_root{};                       /**< Точка монтирования procfs */
+    std::size_t m_workers{};                         /**< Количество потоков проверки */
+    std::mutex m_mutex{};                            /**< Сериализация сканирований */
+    std::unordered_map<int, uint64_t> m_pid_inode{}; /**< Пространство имен процесса (0 - недоступно) */
+    std::map<uint64_t, Entry> m_namespaces{};        /**< Пространства имен по inode */
+};
+
+} // namespace os::network
@@ -0,0 +1,159 @@
+#include "publisher.hpp"
+
+#include <fmt/format.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace os::network {
+
+SnapshotPublisher *SnapshotPublisher::create(PublisherOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new CacheSnapshotPublisher(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+CacheSnapshotPublisher::CacheSnapshotPublisher(PublisherOptions const &options) : m_options{options} {
+    if (m_options.interval.count() <= 0) {
+        throw exceptions::PublisherEx("Publisher interval must be positive");
+    }
+
+    InformerOptions const informer_options{m_options.update_mode, required_caches(m_options.sections)};
+    m_informer = m_options.namespace_fd >= 0 ? InformerNetlink::create_in_namespace(m_options.namespace_fd, informer_options)
+                                             : InformerNetlink::create(informer_options);
+
+    m_stop_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_stop_fd < 0) {
+        throw exceptions::PublisherEx(::fmt::format("Create eventfd: {}", std::strerror(errno)));
+    }
+
+    build();
+}
+
+CacheSnapshotPublisher::~CacheSnapshotPublisher() {
+    stop();
+    ::close(m_stop_fd);
+}
+
+void CacheSnapshotPublisher::start() {
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_thread = std::jthread([this](std::stop_token const &stop) { run(stop); });
+}
+
+void CacheSnapshotPublisher::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_thread.request_stop();
+    // EAGAIN означает переполнение счётчика, то есть дескриптор уже готов к чтению. При другой ошибке
+    // поток проверит признак остановки не позже следующего обновления по расписанию.
+    uint64_t const one = 1;
+    while (::write(m_stop_fd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+    m_thread.join();
+
+    // Счётчик сбрасывается, иначе перезапущенный поток просыпался бы без событий.
+    uint64_t counter = 0;
+    ssize_t ret = 0;
+    while ((ret = ::read(m_stop_fd, &counter, sizeof(counter))) < 0 && errno == EINTR) {
+    }
+    if (ret < 0 && errno != EAGAIN) {
+        throw exceptions::PublisherEx(::fmt::format("Reset eventfd: {}", std::strerror(errno)));
+    }
+}
+
+void CacheSnapshotPublisher::publish() {
+    std::lock_guard const lock(m_informer_mutex);
+    reload();
+    build();
+}
+
+std::shared_ptr<InterfaceSnapshot const> CacheSnapshotPublisher::get_snapshot() const noexcept {
+    std::lock_guard const lock(m_snapshot_mutex);
+    return m_snapshot;
+}
+
+uint64_t CacheSnapshotPublisher::failed_updates() const noexcept {
+    return m_failed_updates.load(std::memory_order_relaxed);
+}
+
+void CacheSnapshotPublisher::run(std::stop_token const &stop) {
+    auto next = std::chrono::steady_clock::now() + m_options.interval;
+    while (!stop.stop_requested()) {
+        auto const now = std::chrono::steady_clock::now();
+        auto const timeout = next > now ? std::chrono::ceil<std::chrono::milliseconds>(next - now).count() : 0;
+
+        pollfd fds[2] = {{m_stop_fd, POLLIN, 0}, {m_informer->get_event_fd(), POLLIN, 0}};
+        int const nfds = fds[1].fd >= 0 ? 2 : 1;
+        if (::poll(fds, nfds, static_cast<int>(timeout)) < 0 && errno != EINTR) {
+            break;
+        }
+        if (stop.stop_requested()) {
+            break;
+        }
+
+        try {
+            std::lock_guard const lock(m_informer_mutex);
+            bool changed = false;
+            if (nfds == 2 && (fds[1].revents & POLLIN)) {
+                changed = m_informer->refresh(0) > 0;
+            }
+            if (std::chrono::steady_clock::now() >= next) {
+                reload();
+                changed = true;
+                next += m_options.interval;
+                if (auto const current = std::chrono::steady_clock::now(); next < current) {
+                    next = current + m_options.interval;
+                }
+            }
+            if (changed) {
+                build();
+            }
+        } catch (std::exception const &) {
+            // Сбой одного обновления (например, ENOBUFS) не прерывает работу: читатели продолжают
+            // получать предыдущий снимок, следующее обновление выполнится по расписанию.
+            m_failed_updates.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void CacheSnapshotPublisher::reload() {
+    if (m_options.update_mode == UpdateMode::Snapshot) {
+        m_informer->refresh(0);
+        return;
+    }
+
+    // Уведомления ядра поддерживают состав кэшей, но счётчики трафика меняются без уведомлений.
+    m_informer->refresh(0);
+    if (has_section(m_options.sections, Section::Rx | Section::Tx)) {
+        m_informer->load_caches(Cache::Link);
+    }
+}
+
+void CacheSnapshotPublisher::build() {
+    auto snapshot = std::make_shared<InterfaceSnapshot>();
+    snapshot->interfaces = m_informer->get_all_interfaces_data(m_options.sections);
+    snapshot->by_name.reserve(snapshot->interfaces.size());
+    for (std::size_t i = 0; i < snapshot->interfaces.size(); ++i) {
+        snapshot->by_name.emplace(snapshot->interfaces[i].interface, i);
+    }
+    snapshot->sections = m_options.sections;
+    snapshot->generation = ++m_generation;
+    snapshot->taken_at = std::chrono::steady_clock::now();
+
+    // Прежний снимок освобождается вне мьютекса, если на него не осталось ссылок у читателей.
+    std::shared_ptr<InterfaceSnapshot const> previous = std::move(snapshot);
+    std::lock_guard const lock(m_snapshot_mutex);
+    m_snapshot.swap(previous);
+}
+
+} // namespace os::network
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "informer/snapshot_publisher.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct PublisherEx
+ * @brief Исключение при ошибке инициализации издателя снимков
+ */
+struct PublisherEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @class CacheSnapshotPublisher
+ * @brief Реализация SnapshotPublisher поверх собственного экземпляра InformerNetlink
+ */
+class CacheSnapshotPublisher final : public SnapshotPublisher {
+   public:
+    /**
+     * @brief Конструктор, создающий кэши и публикующий первый снимок
+     * @param options Параметры издателя
+     * @throw exceptions::PublisherEx если параметры некорректны или не удалось создать eventfd
+     */
+    explicit CacheSnapshotPublisher(PublisherOptions const &options);
+    ~CacheSnapshotPublisher() override;
+
+    CacheSnapshotPublisher(CacheSnapshotPublisher const &) = delete;
+    CacheSnapshotPublisher(CacheSnapshotPublisher &&) = delete;
+    CacheSnapshotPublisher &operator=(CacheSnapshotPublisher const &) = delete;
+    CacheSnapshotPublisher &operator=(CacheSnapshotPublisher &&) = delete;
+
+    void start() override;
+    void stop() override;
+    void publish() override;
+    [[nodiscard]] std::shared_ptr<InterfaceSnapshot const> get_snapshot() const noexcept override;
+    [[nodiscard]] uint64_t failed_updates() const noexcept override;
+
+   private:
+    /**
+     * @brief Тело фонового потока
+     * @param stop Признак остановки
+     */
+    void run(std::stop_token const &stop);
+    /**
+     * @brief Обновляет кэши по расписанию (счётчики не порождают уведомлений ядра)
+     */
+    void reload();
+    /**
+     * @brief Строит снимок из кэшей и публикует его
+     */
+    void build();
+
+    PublisherOptions m_options{};                                       /**< Параметры издателя */
+    std::unique_ptr<InformerNetlink> m_informer{};                      /**< Кэши (только для потока-писателя) */
+    std::mutex m_informer_mutex{};                                      /**< Сериализация публикаций */
+    mutable std::mutex m_snapshot_mutex{};                              /**< Защита указателя на текущий снимок */
+    std::shared_ptr<InterfaceSnapshot const> m_snapshot{};              /**< Текущий снимок */
+    uint64_t m_generation{};                                            /**< Номер последнего снимка */
+    std::atomic<uint64_t> m_failed_updates{};                           /**< Число сбоев обновления в фоновом потоке */
+    int m_stop_fd{-1};                                                  /**< eventfd для пробуждения потока при остановке */
+    std::jthread m_thread{};                                            /**< Фоновый поток */
+};
+
+} // namespace os::network
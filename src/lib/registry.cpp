@@ -0,0 +1,272 @@
+#include "registry.hpp"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <linux/magic.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+namespace os::network {
+
+NamespaceRegistry *NamespaceRegistry::create(RegistryOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new InotifyNamespaceRegistry(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+NetNamespaceHandle::NetNamespaceHandle(int const fd, uint64_t const device, uint64_t const inode) noexcept
+    : m_fd{fd}, m_device{device}, m_inode{inode} {}
+
+NetNamespaceHandle::~NetNamespaceHandle() { ::close(m_fd); }
+
+InotifyNamespaceRegistry::InotifyNamespaceRegistry(RegistryOptions const &options)
+    : m_directory{options.directory}, m_inotify_fd{::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)} {
+    if (m_inotify_fd < 0) {
+        throw exceptions::NamespaceRegistryEx(::fmt::format("Create inotify: {}", std::strerror(errno)));
+    }
+
+    std::unique_lock const lock(m_mutex);
+    watch_directory();
+    rescan();
+}
+
+InotifyNamespaceRegistry::~InotifyNamespaceRegistry() { ::close(m_inotify_fd); }
+
+::nlohmann::json InotifyNamespaceRegistry::get_network_namespaces() const {
+    nlohmann::json json{};
+    nlohmann::json namespaces = nlohmann::json::array();
+
+    std::shared_lock const lock(m_mutex);
+    for (auto const &[name, handle] : m_by_name) {
+        namespaces.emplace_back(name);
+    }
+
+    json["namespaces"] = namespaces;
+    return json;
+}
+
+std::vector<std::string> InotifyNamespaceRegistry::get_names() const {
+    std::shared_lock const lock(m_mutex);
+
+    std::vector<std::string> names;
+    names.reserve(m_by_name.size());
+    for (auto const &[name, handle] : m_by_name) {
+        names.push_back(name);
+    }
+    return names;
+}
+
+std::vector<NetNamespaceEntry> InotifyNamespaceRegistry::get_namespaces() const {
+    std::shared_lock const lock(m_mutex);
+
+    std::vector<NetNamespaceEntry> entries;
+    std::map<NamespaceId, std::size_t> positions;
+    for (auto const &[name, handle] : m_by_name) {
+        auto const [it, inserted] = positions.try_emplace(NamespaceId{handle->device(), handle->inode()}, entries.size());
+        if (inserted) {
+            entries.push_back({{}, handle});
+        }
+        entries[it->second].names.push_back(name);
+    }
+    return entries;
+}
+
+std::shared_ptr<NetNamespaceHandle const> InotifyNamespaceRegistry::find(std::string const &name) const {
+    std::shared_lock const lock(m_mutex);
+
+    auto const it = m_by_name.find(name);
+    return it != m_by_name.end() ? it->second : nullptr;
+}
+
+void InotifyNamespaceRegistry::switch_to_namespace(std::string const &name) const {
+    auto const handle = find(name);
+    if (!handle) {
+        throw exceptions::OpenNamespace(::fmt::format("Open namespace {}", name));
+    }
+    if (::setns(handle->fd(), CLONE_NEWNET) != 0) {
+        throw exceptions::SwitchNamespace(::fmt::format("Switch namespace {}", name));
+    }
+}
+
+int InotifyNamespaceRegistry::get_event_fd() const { return m_inotify_fd; }
+
+int InotifyNamespaceRegistry::refresh(int timeout_ms) {
+    {
+        std::shared_lock const lock(m_mutex);
+        if (!m_pending.empty() && (timeout_ms < 0 || timeout_ms > M_PENDING_RETRY_MS)) {
+            // Монтирование nsfs не порождает событий inotify, поэтому отложенные имена проверяются по таймеру.
+            timeout_ms = M_PENDING_RETRY_MS;
+        }
+    }
+
+    if (timeout_ms != 0) {
+        pollfd fd{m_inotify_fd, POLLIN, 0};
+        ::poll(&fd, 1, timeout_ms);
+    }
+
+    std::unique_lock const lock(m_mutex);
+
+    int changes = 0;
+    if (watch_directory()) {
+        changes += rescan();
+    }
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    bool overflow = false;
+    for (;;) {
+        ssize_t const size = ::read(m_inotify_fd, buffer, sizeof(buffer));
+        if (size <= 0) {
+            break;
+        }
+
+        for (char const *ptr = buffer; ptr < buffer + size;) {
+            auto const *const event = reinterpret_cast<inotify_event const *>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                overflow = true;
+            } else if (event->wd != m_watch) {
+                continue;
+            } else if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                if (!(event->mask & IN_IGNORED)) {
+                    ::inotify_rm_watch(m_inotify_fd, m_watch);
+                }
+                m_watch = -1;
+                changes += clear();
+            } else if (event->len == 0 || event->name[0] == '.') {
+                continue;
+            } else if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                changes += add(event->name) ? 1 : 0;
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                changes += remove(event->name) ? 1 : 0;
+            }
+        }
+    }
+
+    if (overflow) {
+        changes += rescan();
+    }
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        std::string const name = *it++;
+        changes += add(name) ? 1 : 0;
+    }
+    return changes;
+}
+
+bool InotifyNamespaceRegistry::watch_directory() {
+    if (m_watch >= 0) {
+        return false;
+    }
+    m_watch = ::inotify_add_watch(m_inotify_fd, m_directory.c_str(),
+                                  IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+    return m_watch >= 0;
+}
+
+int InotifyNamespaceRegistry::rescan() {
+    std::set<std::string> present;
+    if (auto const dir = opendir(m_directory.c_str())) {
+        dirent *entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (entry->d_name[0] != '.') {
+                present.emplace(entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+
+    int changes = 0;
+    for (auto it = m_by_name.begin(); it != m_by_name.end();) {
+        std::string const name = (it++)->first;
+        if (!present.contains(name)) {
+            changes += remove(name) ? 1 : 0;
+        }
+    }
+    std::erase_if(m_pending, [&present](std::string const &name) { return !present.contains(name); });
+    for (auto const &name : present) {
+        if (!m_by_name.contains(name)) {
+            changes += add(name) ? 1 : 0;
+        }
+    }
+    return changes;
+}
+
+bool InotifyNamespaceRegistry::add(std::string const &name) {
+    std::string const path = m_directory + "/" + name;
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            m_pending.erase(name);
+        } else {
+            m_pending.insert(name);
+        }
+        return false;
+    }
+
+    struct statfs fs{};
+    struct stat st{};
+    if (::fstatfs(fd, &fs) != 0 || fs.f_type != NSFS_MAGIC || ::fstat(fd, &st) != 0) {
+        // Файл создан, но пространство имен на него ещё не смонтировано.
+        ::close(fd);
+        m_pending.insert(name);
+        return false;
+    }
+    m_pending.erase(name);
+
+    // Номера inode уникальны только в пределах устройства.
+    NamespaceId const id{st.st_dev, st.st_ino};
+    std::shared_ptr<NetNamespaceHandle const> handle;
+    if (auto const same = m_by_id.find(id); same != m_by_id.end()) {
+        handle = same->second.lock();
+    }
+    if (handle) {
+        ::close(fd);
+    } else {
+        handle = std::make_shared<NetNamespaceHandle const>(fd, st.st_dev, st.st_ino);
+        m_by_id.insert_or_assign(id, handle);
+    }
+
+    auto const previous = m_by_name.find(name);
+    bool const changed = previous == m_by_name.end() || previous->second != handle;
+    m_by_name.insert_or_assign(name, std::move(handle));
+    return changed;
+}
+
+bool InotifyNamespaceRegistry::remove(std::string const &name) {
+    m_pending.erase(name);
+
+    auto const it = m_by_name.find(name);
+    if (it == m_by_name.end()) {
+        return false;
+    }
+
+    NamespaceId const id{it->second->device(), it->second->inode()};
+    m_by_name.erase(it);
+    if (auto const same = m_by_id.find(id); same != m_by_id.end() && same->second.expired()) {
+        m_by_id.erase(same);
+    }
+    return true;
+}
+
+int InotifyNamespaceRegistry::clear() {
+    auto const count = static_cast<int>(m_by_name.size());
+    m_by_name.clear();
+    m_by_id.clear();
+    m_pending.clear();
+    return count;
+}
+
+} // namespace os::network
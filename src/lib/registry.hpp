@@ -0,0 +1,100 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "informer/namespace_registry.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct NamespaceRegistryEx
+ * @brief Исключение при ошибке инициализации реестра пространств имен
+ */
+struct NamespaceRegistryEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @class InotifyNamespaceRegistry
+ * @brief Реализация NamespaceRegistry, отслеживающая каталог пространств имен через inotify
+ */
+class InotifyNamespaceRegistry final : public NamespaceRegistry {
+   public:
+    /**
+     * @brief Конструктор, выполняющий первичное сканирование каталога
+     * @param options Параметры реестра
+     * @throw exceptions::NamespaceRegistryEx если не удалось создать дескриптор inotify
+     */
+    explicit InotifyNamespaceRegistry(RegistryOptions const &options);
+    ~InotifyNamespaceRegistry() override;
+
+    InotifyNamespaceRegistry(InotifyNamespaceRegistry const &) = delete;
+    InotifyNamespaceRegistry(InotifyNamespaceRegistry &&) = delete;
+    InotifyNamespaceRegistry &operator=(InotifyNamespaceRegistry const &) = delete;
+    InotifyNamespaceRegistry &operator=(InotifyNamespaceRegistry &&) = delete;
+
+    [[nodiscard]] ::nlohmann::json get_network_namespaces() const override;
+    [[nodiscard]] std::vector<std::string> get_names() const override;
+    [[nodiscard]] std::vector<NetNamespaceEntry> get_namespaces() const override;
+    [[nodiscard]] std::shared_ptr<NetNamespaceHandle const> find(std::string const &name) const override;
+    void switch_to_namespace(std::string const &name) const override;
+    [[nodiscard]] int get_event_fd() const override;
+    int refresh(int timeout_ms) override;
+
+   private:
+    /**
+     * @brief Идентификатор пространства имен: номер устройства и inode файла nsfs
+     */
+    using NamespaceId = std::pair<uint64_t, uint64_t>;
+
+    /**
+     * @brief Ставит наблюдение за каталогом, если оно ещё не установлено (каталог может появиться позже)
+     * @return true, если наблюдение установлено этим вызовом
+     */
+    bool watch_directory();
+    /**
+     * @brief Приводит реестр в соответствие с содержимым каталога
+     * @return Количество добавленных и удалённых имён
+     */
+    int rescan();
+    /**
+     * @brief Открывает и регистрирует имя; имя, ещё не смонтированное как nsfs, откладывается
+     * @param name Имя пространства имен
+     * @return true, если имя добавлено
+     */
+    bool add(std::string const &name);
+    /**
+     * @brief Удаляет имя из реестра
+     * @param name Имя пространства имен
+     * @return true, если имя было зарегистрировано
+     */
+    bool remove(std::string const &name);
+    /**
+     * @brief Удаляет все имена (каталог удалён или перемещён)
+     * @return Количество удалённых имён
+     */
+    int clear();
+
+    /**
+     * @brief Максимальное время ожидания в refresh() при наличии отложенных имён, мс
+     */
+    static constexpr int M_PENDING_RETRY_MS = 100;
+
+    std::string m_directory{};                                                    /**< Каталог пространств имен */
+    int m_inotify_fd{-1};                                                         /**< Дескриптор inotify */
+    int m_watch{-1};                                                              /**< Наблюдение за каталогом */
+    mutable std::shared_mutex m_mutex{};                                          /**< Защита таблиц */
+    std::map<std::string, std::shared_ptr<NetNamespaceHandle const>> m_by_name{}; /**< Пространства имен по имени */
+    std::map<NamespaceId, std::weak_ptr<NetNamespaceHandle const>> m_by_id{};     /**< Пространства имен по устройству и inode */
+    std::set<std::string> m_pending{};                                            /**< Имена, ожидающие монтирования */
+};
+
+} // namespace os::network
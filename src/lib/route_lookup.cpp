@@ -0,0 +1,179 @@
+#include "route_lookup.hpp"
+
+#include <linux/rtnetlink.h>
+#include <netlink/addr.h>
+#include <netlink/object.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @brief Проверяет, участвует ли маршрут в поиске
+ *
+ * Маршруты с ненулевым TOS выбираются ядром только для пакетов с тем же TOS, а поиск выполняется
+ * для TOS 0; кэшированные маршруты (RTM_F_CLONED) не являются записями таблицы.
+ * @param route Маршрут
+ * @return true, если маршрут индексируется
+ */
+bool is_indexed(rtnl_route *route) {
+    int const family = rtnl_route_get_family(route);
+    return (family == AF_INET || family == AF_INET6) && rtnl_route_get_tos(route) == 0 && (rtnl_route_get_flags(route) & RTM_F_CLONED) == 0;
+}
+
+/**
+ * @brief Копирует адрес назначения маршрута в буфер фиксированного размера
+ * @param route Маршрут
+ * @param out Буфер (дополняется нулями, если адрес короче, как у маршрута по умолчанию)
+ * @param size Размер буфера
+ * @return Длина префикса
+ */
+unsigned destination(rtnl_route *route, unsigned char *out, std::size_t const size) {
+    std::memset(out, 0, size);
+    nl_addr *const dst = rtnl_route_get_dst(route);
+    if (dst == nullptr) {
+        return 0;
+    }
+    std::memcpy(out, nl_addr_get_binary_addr(dst), std::min<std::size_t>(nl_addr_get_len(dst), size));
+    return std::min<unsigned>(nl_addr_get_prefixlen(dst), size * 8);
+}
+
+/**
+ * @brief Преобразует адрес IPv4 в ключ дерева
+ * @param bytes Адрес в сетевом порядке байт
+ * @return Ключ
+ */
+uint32_t ipv4_key(unsigned char const *bytes) {
+    return static_cast<uint32_t>(bytes[0]) << 24 | static_cast<uint32_t>(bytes[1]) << 16 | static_cast<uint32_t>(bytes[2]) << 8 | bytes[3];
+}
+
+/**
+ * @brief Преобразует адрес IPv6 в ключ дерева
+ * @param bytes Адрес в сетевом порядке байт
+ * @return Ключ
+ */
+Ipv6Key ipv6_key(unsigned char const *bytes) {
+    Ipv6Key key = 0;
+    for (int i = 0; i < 16; i++) {
+        key = key << 8 | bytes[i];
+    }
+    return key;
+}
+
+} // namespace
+
+RouteLookupTable::Bucket *RouteLookupTable::bucket(rtnl_route *route, bool const create) {
+    uint32_t const table = rtnl_route_get_table(route);
+    unsigned char bytes[16];
+
+    if (rtnl_route_get_family(route) == AF_INET) {
+        unsigned const length = destination(route, bytes, 4);
+        if (!create) {
+            auto const trie = m_ipv4.find(table);
+            return trie == m_ipv4.end() ? nullptr : trie->second.find(ipv4_key(bytes), length);
+        }
+        return &m_ipv4[table].insert(ipv4_key(bytes), length);
+    }
+
+    unsigned const length = destination(route, bytes, 16);
+    if (!create) {
+        auto const trie = m_ipv6.find(table);
+        return trie == m_ipv6.end() ? nullptr : trie->second.find(ipv6_key(bytes), length);
+    }
+    return &m_ipv6[table].insert(ipv6_key(bytes), length);
+}
+void RouteLookupTable::erase_bucket(rtnl_route *route) {
+    uint32_t const table = rtnl_route_get_table(route);
+    unsigned char bytes[16];
+
+    if (rtnl_route_get_family(route) == AF_INET) {
+        unsigned const length = destination(route, bytes, 4);
+        auto const trie = m_ipv4.find(table);
+        trie->second.erase(ipv4_key(bytes), length);
+        if (trie->second.size() == 0) {
+            m_ipv4.erase(trie);
+        }
+        return;
+    }
+
+    unsigned const length = destination(route, bytes, 16);
+    auto const trie = m_ipv6.find(table);
+    trie->second.erase(ipv6_key(bytes), length);
+    if (trie->second.size() == 0) {
+        m_ipv6.erase(trie);
+    }
+}
+void RouteLookupTable::add(rtnl_route *route) {
+    if (!is_indexed(route)) {
+        return;
+    }
+
+    Bucket &routes = *bucket(route, true);
+    for (auto &existing : routes) {
+        if (nl_object_identical(OBJ_CAST(existing.get()), OBJ_CAST(route))) {
+            // Тот же маршрут в новом состоянии (например, после добавления nexthop).
+            nl_object_get(OBJ_CAST(route));
+            existing.reset(route);
+            return;
+        }
+    }
+
+    // Корзины короткие (обычно один маршрут), поэтому вставка сохраняет порядок по метрике.
+    uint32_t const priority = rtnl_route_get_priority(route);
+    auto const position = std::find_if(routes.begin(), routes.end(), [priority](RoutePtr const &existing) {
+        return rtnl_route_get_priority(existing.get()) > priority;
+    });
+    nl_object_get(OBJ_CAST(route));
+    routes.emplace(position, route, rtnl_route_put);
+    ++m_size;
+}
+void RouteLookupTable::remove(rtnl_route *route) {
+    if (!is_indexed(route)) {
+        return;
+    }
+
+    Bucket *const routes = bucket(route, false);
+    if (routes == nullptr) {
+        return;
+    }
+    auto const it = std::find_if(routes->begin(), routes->end(), [route](RoutePtr const &existing) {
+        return nl_object_identical(OBJ_CAST(existing.get()), OBJ_CAST(route)) != 0;
+    });
+    if (it == routes->end()) {
+        return;
+    }
+    routes->erase(it);
+    --m_size;
+    if (routes->empty()) {
+        erase_bucket(route);
+    }
+}
+void RouteLookupTable::clear() {
+    m_ipv4.clear();
+    m_ipv6.clear();
+    m_size = 0;
+}
+rtnl_route *RouteLookupTable::lookup(int const family, void const *address, uint32_t const table) const {
+    auto const *const bytes = static_cast<unsigned char const *>(address);
+    Bucket const *routes = nullptr;
+
+    if (family == AF_INET) {
+        auto const trie = m_ipv4.find(table);
+        if (trie != m_ipv4.end()) {
+            routes = trie->second.match(ipv4_key(bytes));
+        }
+    } else if (family == AF_INET6) {
+        auto const trie = m_ipv6.find(table);
+        if (trie != m_ipv6.end()) {
+            routes = trie->second.match(ipv6_key(bytes));
+        }
+    }
+
+    return routes == nullptr || routes->empty() ? nullptr : routes->front().get();
+}
+
+} // namespace os::network
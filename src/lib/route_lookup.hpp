@@ -0,0 +1,78 @@
+#pragma once
+
+#include <netlink/route/route.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "prefix_trie.hpp"
+
+namespace os::network {
+
+/**
+ * @class RouteLookupTable
+ * @brief Индекс маршрутов для поиска по наибольшему совпадению префикса
+ *
+ * Для каждой пары (таблица маршрутизации, семейство адресов) строится отдельное дерево префиксов.
+ * Префиксу соответствуют все маршруты с этим назначением, упорядоченные по метрике; при поиске
+ * выбирается маршрут с наименьшей метрикой, как это делает ядро. Индекс удерживает ссылки на
+ * объекты маршрутов, поэтому найденный маршрут остаётся действительным до его удаления из индекса.
+ */
+class RouteLookupTable final {
+   public:
+    using RoutePtr = std::unique_ptr<rtnl_route, decltype(&rtnl_route_put)>;
+
+    /**
+     * @brief Добавляет маршрут (маршруты с TOS, кэшированные и не-IP маршруты пропускаются)
+     * @param route Маршрут; индекс берёт собственную ссылку
+     */
+    void add(rtnl_route *route);
+    /**
+     * @brief Удаляет маршрут с теми же ключевыми атрибутами (таблица, назначение, TOS, метрика)
+     * @param route Маршрут или его копия
+     */
+    void remove(rtnl_route *route);
+    /**
+     * @brief Удаляет все маршруты
+     */
+    void clear();
+    /**
+     * @brief Находит маршрут с наиболее длинным префиксом, покрывающим адрес
+     * @param family AF_INET или AF_INET6
+     * @param address Адрес в сетевом порядке байт (4 или 16 байт)
+     * @param table Таблица маршрутизации
+     * @return Маршрут с наименьшей метрикой среди маршрутов найденного префикса или nullptr
+     */
+    [[nodiscard]] rtnl_route *lookup(int family, void const *address, uint32_t table) const;
+    /**
+     * @brief Возвращает количество маршрутов в индексе
+     * @return Количество маршрутов
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+   private:
+    using Bucket = std::vector<RoutePtr>;
+    using Ipv4Trie = PrefixTrie<uint32_t, Bucket>;
+    using Ipv6Trie = PrefixTrie<Ipv6Key, Bucket>;
+
+    /**
+     * @brief Находит корзину префикса назначения маршрута
+     * @param route Маршрут
+     * @param create Создавать корзину (и дерево таблицы) при отсутствии
+     * @return Указатель на корзину или nullptr
+     */
+    Bucket *bucket(rtnl_route *route, bool create);
+    /**
+     * @brief Удаляет пустую корзину префикса назначения маршрута
+     * @param route Маршрут
+     */
+    void erase_bucket(rtnl_route *route);
+
+    std::unordered_map<uint32_t, Ipv4Trie> m_ipv4{}; /**< Деревья IPv4 по номеру таблицы */
+    std::unordered_map<uint32_t, Ipv6Trie> m_ipv6{}; /**< Деревья IPv6 по номеру таблицы */
+    std::size_t m_size{};                            /**< Количество маршрутов */
+};
+
+} // namespace os::network
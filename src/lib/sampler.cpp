@@ -0,0 +1,276 @@
+#include "sampler.hpp"
+
+#include <fmt/format.h>
+#include <linux/if_link.h>
+#include <linux/rtnetlink.h>
+#include <netlink/msg.h>
+#include <netlink/route/rtnl.h>
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+namespace os::network {
+
+namespace {
+/**
+ * Размер буфера приёма: ядро ограничивает одну датаграмму дампа 32 КБ.
+ */
+constexpr std::size_t M_RECEIVE_BUFFER_SIZE = 64 * 1024;
+} // namespace
+
+CounterSampler *CounterSampler::create(SamplerOptions const &options, char *error_message) noexcept {
+    try {
+        auto *new_object = new NetlinkCounterSampler(options);
+        return new_object;
+    } catch (std::exception const &ex) {
+        ::snprintf(error_message, M_MAX_BUFFER_SIZE, "Cannot create new object %s", ex.what());
+        return nullptr;
+    }
+}
+
+CounterRing::CounterRing(std::size_t const capacity) : m_samples(capacity) {}
+
+void CounterRing::push(CounterSample const &sample) noexcept {
+    m_samples[m_head] = sample;
+    m_head = (m_head + 1) % m_samples.size();
+    m_size = std::min(m_size + 1, m_samples.size());
+}
+
+CounterSample const &CounterRing::newest(std::size_t const age) const noexcept {
+    return m_samples[(m_head + m_samples.size() - 1 - age) % m_samples.size()];
+}
+
+NetlinkCounterSampler::NetlinkCounterSampler(SamplerOptions const &options)
+    : m_options{options}, m_netlink_socket{nl_socket_alloc(), nl_socket_free}, m_receive_buffer(M_RECEIVE_BUFFER_SIZE) {
+    if (m_options.capacity < 2 || m_options.interval.count() <= 0) {
+        throw exceptions::SamplerEx("Sampler capacity must be at least 2 and interval must be positive");
+    }
+
+    if (!m_netlink_socket) {
+        throw exceptions::SamplerEx("Allocate netlink socket");
+    }
+
+    if (nl_connect(m_netlink_socket.get(), NETLINK_ROUTE) < 0) {
+        throw exceptions::SamplerEx("Connect to NETLINK_ROUTE");
+    }
+}
+
+NetlinkCounterSampler::~NetlinkCounterSampler() { stop(); }
+
+void NetlinkCounterSampler::start() {
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_thread = std::jthread([this](std::stop_token const &stop) { run(stop); });
+}
+
+void NetlinkCounterSampler::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    m_thread.request_stop();
+    m_thread.join();
+}
+
+void NetlinkCounterSampler::run(std::stop_token const &stop) {
+    std::mutex wait_mutex;
+    std::unique_lock lock(wait_mutex);
+
+    auto next = std::chrono::steady_clock::now();
+    while (!stop.stop_requested()) {
+        try {
+            sample();
+        } catch (std::exception const &) {
+            // Единичный сбой дампа (например, ENOBUFS) пропускается: следующий отсчёт будет снят по расписанию.
+        }
+
+        next += m_options.interval;
+        if (auto const now = std::chrono::steady_clock::now(); next < now) {
+            next = now;
+        }
+        m_wakeup.wait_until(lock, stop, next, [] { return false; });
+    }
+}
+
+void NetlinkCounterSampler::sample() {
+    std::lock_guard const socket_lock(m_socket_mutex);
+
+    m_sample_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    ++m_generation;
+
+    // nl_rtgen_request и nl_recvmsgs выделяют память под каждое сообщение, поэтому запрос и приём выполняются напрямую.
+    int const fd = nl_socket_get_fd(m_netlink_socket.get());
+    struct {
+        nlmsghdr header;
+        rtgenmsg body;
+    } request{};
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(request.body));
+    request.header.nlmsg_type = RTM_GETLINK;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = nl_socket_use_seq(m_netlink_socket.get());
+    request.header.nlmsg_pid = nl_socket_get_local_port(m_netlink_socket.get());
+    request.body.rtgen_family = AF_UNSPEC;
+    if (::send(fd, &request, request.header.nlmsg_len, 0) < 0) {
+        throw exceptions::SamplerEx(::fmt::format("Request link dump: {}", std::strerror(errno)));
+    }
+
+    for (bool done = false; !done;) {
+        ssize_t const received = ::recv(fd, m_receive_buffer.data(), m_receive_buffer.size(), MSG_TRUNC);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw exceptions::SamplerEx(::fmt::format("Receive link dump: {}", std::strerror(errno)));
+        }
+        if (static_cast<std::size_t>(received) > m_receive_buffer.size()) {
+            throw exceptions::SamplerEx("Receive link dump: message truncated");
+        }
+
+        int remaining = static_cast<int>(received);
+        for (auto *hdr = reinterpret_cast<nlmsghdr *>(m_receive_buffer.data()); nlmsg_ok(hdr, remaining); hdr = nlmsg_next(hdr, &remaining)) {
+            if (hdr->nlmsg_seq != request.header.nlmsg_seq) {
+                continue;
+            }
+            if (hdr->nlmsg_flags & NLM_F_DUMP_INTR) {
+                throw exceptions::SamplerEx("Receive link dump: dump interrupted");
+            }
+            if (hdr->nlmsg_type == NLMSG_DONE) {
+                done = true;
+                break;
+            }
+            if (hdr->nlmsg_type == NLMSG_ERROR) {
+                auto const *const error = static_cast<nlmsgerr const *>(nlmsg_data(hdr));
+                if (error->error == 0) {
+                    done = true;
+                    break;
+                }
+                throw exceptions::SamplerEx(::fmt::format("Receive link dump: {}", std::strerror(-error->error)));
+            }
+            on_link_message(hdr);
+        }
+    }
+
+    // Интерфейсы, отсутствующие в дампе, удалены: их буферы освобождаются.
+    std::lock_guard const lock(m_mutex);
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.generation != m_generation) {
+            forget_name(it->second.name.data(), it->first);
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NetlinkCounterSampler::on_link_message(nlmsghdr *hdr) {
+    if (hdr->nlmsg_type != RTM_NEWLINK) {
+        return;
+    }
+
+    nlattr *attrs[IFLA_MAX + 1];
+    if (nlmsg_parse(hdr, sizeof(ifinfomsg), attrs, IFLA_MAX, nullptr) < 0 || !attrs[IFLA_IFNAME] || !attrs[IFLA_STATS64]) {
+        return;
+    }
+
+    auto const *const info = static_cast<ifinfomsg const *>(nlmsg_data(hdr));
+    auto const *const if_name = static_cast<char const *>(nla_data(attrs[IFLA_IFNAME]));
+
+    rtnl_link_stats64 stats{};
+    std::memcpy(&stats, nla_data(attrs[IFLA_STATS64]), std::min<std::size_t>(sizeof(stats), nla_len(attrs[IFLA_STATS64])));
+
+    std::lock_guard const lock(m_mutex);
+
+    auto it = m_entries.find(info->ifi_index);
+    if (it == m_entries.end()) {
+        // Единственное место выделения памяти при опросе: буфер для впервые увиденного интерфейса.
+        it = m_entries.emplace(info->ifi_index, Entry{{}, CounterRing{m_options.capacity}, 0}).first;
+    }
+
+    Entry &entry = it->second;
+    if (std::strncmp(entry.name.data(), if_name, entry.name.size()) != 0) {
+        forget_name(entry.name.data(), info->ifi_index);
+        std::strncpy(entry.name.data(), if_name, entry.name.size() - 1);
+        m_names.insert_or_assign(entry.name.data(), info->ifi_index);
+    }
+
+    entry.generation = m_generation;
+    entry.ring.push({m_sample_time_ns, stats.rx_bytes, stats.rx_packets, stats.tx_bytes, stats.tx_packets});
+}
+
+void NetlinkCounterSampler::forget_name(char const *name, int const ifindex) {
+    if (auto const it = m_names.find(name); it != m_names.end() && it->second == ifindex) {
+        m_names.erase(it);
+    }
+}
+
+std::optional<InterfaceRates> NetlinkCounterSampler::get_rates(std::string const &interface_name, std::chrono::milliseconds const window) const {
+    std::lock_guard const lock(m_mutex);
+
+    auto const name = m_names.find(interface_name);
+    if (name == m_names.end()) {
+        return std::nullopt;
+    }
+    CounterRing const &ring = m_entries.at(name->second).ring;
+
+    int64_t const window_start = ring.newest(0).timestamp_ns - std::chrono::duration_cast<std::chrono::nanoseconds>(window).count();
+    std::size_t count = 1;
+    while (count < ring.size() && ring.newest(count).timestamp_ns >= window_start) {
+        ++count;
+    }
+    if (count < 2) {
+        return std::nullopt;
+    }
+
+    auto const stats_for = [&ring, count](uint64_t CounterSample::*counter) {
+        std::vector<double> rates;
+        rates.reserve(count - 1);
+
+        uint64_t total = 0;
+        int64_t total_ns = 0;
+        for (std::size_t age = 0; age + 1 < count; ++age) {
+            auto const &newer = ring.newest(age);
+            auto const &older = ring.newest(age + 1);
+            int64_t const dt = newer.timestamp_ns - older.timestamp_ns;
+
+            // Уменьшение счётчика означает его сброс (например, пересоздание драйвером) - интервал пропускается.
+            if (dt <= 0 || newer.*counter < older.*counter) {
+                continue;
+            }
+
+            uint64_t const delta = newer.*counter - older.*counter;
+            total += delta;
+            total_ns += dt;
+            rates.push_back(static_cast<double>(delta) * 1e9 / static_cast<double>(dt));
+        }
+
+        RateStats stats{};
+        if (rates.empty()) {
+            return stats;
+        }
+
+        auto const [min, max] = std::minmax_element(rates.begin(), rates.end());
+        stats.min = *min;
+        stats.max = *max;
+        stats.avg = static_cast<double>(total) * 1e9 / static_cast<double>(total_ns);
+
+        auto const rank = static_cast<std::size_t>(std::ceil(0.95 * static_cast<double>(rates.size()))) - 1;
+        std::nth_element(rates.begin(), rates.begin() + static_cast<std::ptrdiff_t>(rank), rates.end());
+        stats.p95 = rates[rank];
+        return stats;
+    };
+
+    InterfaceRates result;
+    result.interface = interface_name;
+    result.rx_bytes = stats_for(&CounterSample::rx_bytes);
+    result.rx_packets = stats_for(&CounterSample::rx_packets);
+    result.tx_bytes = stats_for(&CounterSample::tx_bytes);
+    result.tx_packets = stats_for(&CounterSample::tx_packets);
+    result.samples = count;
+    return result;
+}
+
+} // namespace os::network
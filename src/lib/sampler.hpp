@@ -0,0 +1,148 @@
+#pragma once
+
+#include <net/if.h>
+#include <netlink/netlink.h>
+#include <netlink/socket.h>
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "informer/counter_sampler.hpp"
+
+namespace os::network {
+
+namespace exceptions {
+/**
+ * @struct SamplerEx
+ * @brief Исключение при ошибке опроса счётчиков интерфейсов
+ */
+struct SamplerEx final : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace exceptions
+
+/**
+ * @struct CounterSample
+ * @brief Один отсчёт счётчиков интерфейса
+ */
+struct CounterSample {
+    int64_t timestamp_ns{}; /**< Момент отсчёта (steady_clock), нс */
+    uint64_t rx_bytes{};    /**< Принято байт */
+    uint64_t rx_packets{};  /**< Принято пакетов */
+    uint64_t tx_bytes{};    /**< Отправлено байт */
+    uint64_t tx_packets{};  /**< Отправлено пакетов */
+};
+
+/**
+ * @class CounterRing
+ * @brief Кольцевой буфер отсчётов фиксированного размера, выделяемый один раз при создании
+ */
+class CounterRing {
+   public:
+    /**
+     * @brief Выделяет буфер на заданное количество отсчётов
+     * @param capacity Ёмкость буфера
+     */
+    explicit CounterRing(std::size_t capacity);
+
+    /**
+     * @brief Добавляет отсчёт, вытесняя самый старый при заполнении (без выделения памяти)
+     * @param sample Отсчёт
+     */
+    void push(CounterSample const &sample) noexcept;
+    /**
+     * @brief Количество сохранённых отсчётов
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    /**
+     * @brief Возвращает отсчёт по возрасту
+     * @param age 0 - самый новый отсчёт, size() - 1 - самый старый
+     * @return Ссылка на отсчёт
+     */
+    [[nodiscard]] CounterSample const &newest(std::size_t age) const noexcept;
+
+   private:
+    std::vector<CounterSample> m_samples; /**< Хранилище отсчётов */
+    std::size_t m_head{};                 /**< Позиция следующей записи */
+    std::size_t m_size{};                 /**< Количество сохранённых отсчётов */
+};
+
+/**
+ * @class NetlinkCounterSampler
+ * @brief Реализация CounterSampler, читающая счётчики дампом RTM_GETLINK
+ *
+ * Запрос дампа формируется на стеке, а ответ принимается recv в буфер, выделенный при создании, и
+ * разбирается напрямую (IFLA_IFNAME, IFLA_STATS64) без объектов nl_msg и кэша libnl.
+ */
+class NetlinkCounterSampler final : public CounterSampler {
+   public:
+    /**
+     * @brief Конструктор, открывающий сокет Netlink в текущем пространстве имен
+     * @param options Параметры опроса
+     * @throw exceptions::SamplerEx если не удалось открыть сокет или параметры некорректны
+     */
+    explicit NetlinkCounterSampler(SamplerOptions const &options);
+    ~NetlinkCounterSampler() override;
+
+    NetlinkCounterSampler(NetlinkCounterSampler const &) = delete;
+    NetlinkCounterSampler(NetlinkCounterSampler &&) = delete;
+    NetlinkCounterSampler &operator=(NetlinkCounterSampler const &) = delete;
+    NetlinkCounterSampler &operator=(NetlinkCounterSampler &&) = delete;
+
+    void start() override;
+    void stop() override;
+    void sample() override;
+    [[nodiscard]] std::optional<InterfaceRates> get_rates(std::string const &interface_name,
+                                                          std::chrono::milliseconds window) const override;
+
+   private:
+    /**
+     * @struct Entry
+     * @brief Кольцевой буфер и имя интерфейса
+     */
+    struct Entry {
+        std::array<char, IF_NAMESIZE> name{}; /**< Имя интерфейса на момент последнего отсчёта */
+        CounterRing ring;                     /**< Отсчёты */
+        uint64_t generation{};                /**< Номер опроса, в котором интерфейс был виден последний раз */
+    };
+
+    /**
+     * @brief Обрабатывает сообщение RTM_NEWLINK из дампа
+     * @param hdr Сообщение Netlink
+     */
+    void on_link_message(nlmsghdr *hdr);
+    /**
+     * @brief Удаляет имя из индекса, если оно всё ещё указывает на данный интерфейс
+     *
+     * Имя может уже принадлежать другому интерфейсу, переименованному в том же дампе раньше.
+     * @param name Прежнее имя интерфейса
+     * @param ifindex Индекс интерфейса
+     */
+    void forget_name(char const *name, int ifindex);
+    /**
+     * @brief Тело фонового потока опроса
+     * @param stop Признак остановки
+     */
+    void run(std::stop_token const &stop);
+
+    SamplerOptions m_options{};                                                                    /**< Параметры опроса */
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> m_netlink_socket{nullptr, nl_socket_free}; /**< Сокет Netlink */
+    std::vector<char> m_receive_buffer{};                                                          /**< Буфер приёма дампа */
+    std::mutex m_socket_mutex{};                                                                   /**< Сериализация опросов и буфера приёма */
+    mutable std::mutex m_mutex{};                                                                  /**< Защита буферов */
+    std::unordered_map<int, Entry> m_entries{};                                                    /**< Буферы по ifindex */
+    std::unordered_map<std::string, int> m_names{};                                                /**< ifindex по имени */
+    int64_t m_sample_time_ns{};                                                                    /**< Время текущего отсчёта */
+    uint64_t m_generation{};                                                                       /**< Номер текущего опроса */
+    std::condition_variable_any m_wakeup{};                                                        /**< Ожидание следующего отсчёта */
+    std::jthread m_thread{};                                                                       /**< Поток опроса */
+};
+
+} // namespace os::network
@@ -0,0 +1,372 @@
+#include "informer/snapshot_codec.hpp"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <bit>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace os::network {
+
+namespace {
+
+/**
+ * @brief Сигнатура двоичного снимка
+ */
+constexpr std::array<uint8_t, 3> M_MAGIC{'I', 'F', 'S'};
+
+/**
+ * @brief Имена флагов интерфейса в порядке бит маски (совпадает с порядком general.flags)
+ */
+constexpr std::array<std::string_view, 15> M_LINK_FLAGS{"UP",     "BROADCAST", "DEBUG",   "LOOPBACK",  "POINTOPOINT",
+                                                        "RUNNING", "NOARP",     "PROMISC", "ALLMULTI",  "MASTER",
+                                                        "SLAVE",   "MULTICAST", "PORTSEL", "AUTOMEDIA", "DYNAMIC"};
+/**
+ * @brief Имена флагов адреса в порядке бит маски (совпадает с порядком ip.flags)
+ */
+constexpr std::array<std::string_view, 8> M_ADDR_FLAGS{"PERMANENT", "SECONDARY", "TENTATIVE",  "DEPRECATED",
+                                                       "HOME",      "NODAD",     "OPTIMISTIC", "TEMPORARY"};
+/**
+ * @brief Имена состояний соседа в порядке бит маски (совпадает с порядком neigh.type)
+ */
+constexpr std::array<std::string_view, 8> M_NEIGH_STATES{"INCOMPLETE", "REACHABLE", "STALE", "DELAY",
+                                                         "PROBE",      "FAILED",    "NOARP", "PERMANENT"};
+
+/**
+ * @class SnapshotEncoder
+ * @brief Кодирует интерфейсы в тело снимка, собирая таблицу строк
+ */
+class SnapshotEncoder {
+   public:
+    explicit SnapshotEncoder(Section const sections) : m_sections{sections} {}
+
+    void encode(Json const &info) {
+        string(info.interface);
+        if (has_section(m_sections, Section::General)) {
+            string(info.general.state);
+            string(info.general.type);
+            flags(info.general.flags, M_LINK_FLAGS);
+            signed_number(info.general.index);
+        }
+        if (has_section(m_sections, Section::HW)) {
+            string(info.hw.type);
+            strings(info.hw.mac);
+            number(info.hw.mtu);
+            number(info.hw.size_queue);
+        }
+        if (has_section(m_sections, Section::OperationalStatus)) {
+            string(info.operational_status.oper_state);
+            string(info.operational_status.link_mode);
+        }
+        if (has_section(m_sections, Section::Protocols)) {
+            m_body.push_back(static_cast<uint8_t>((info.protocols.routing_ipv4 ? 1u : 0u) | (info.protocols.multicast ? 2u : 0u)));
+        }
+        if (has_section(m_sections, Section::Ip)) {
+            number(info.ip.size());
+            for (auto const &ip : info.ip) {
+                string(ip.type);
+                string(ip.ip);
+                string(ip.broadcast);
+                string(ip.peer);
+                flags(ip.flags, M_ADDR_FLAGS);
+                signed_number(ip.masc);
+                number(ip.valid_lft);
+                number(ip.pref_lft);
+            }
+        }
+        if (has_section(m_sections, Section::Routes)) {
+            number(info.routes.size());
+            for (auto const &route : info.routes) {
+                string(route.destination);
+                string(route.gateway);
+                string(route.type);
+                number(route.metric);
+                number(route.table);
+            }
+        }
+        if (has_section(m_sections, Section::Neigh)) {
+            number(info.neigh.size());
+            for (auto const &neigh : info.neigh) {
+                string(neigh.ip);
+                string(neigh.mac);
+                flags(neigh.type, M_NEIGH_STATES);
+            }
+        }
+        if (has_section(m_sections, Section::Tx)) {
+            packetometr(info.tx);
+        }
+        if (has_section(m_sections, Section::Rx)) {
+            packetometr(info.rx);
+        }
+    }
+    /**
+     * @brief Дописывает заголовок, таблицу строк и тело в буфер
+     * @param out Буфер
+     * @param count Количество закодированных интерфейсов
+     */
+    void finish(std::vector<uint8_t> &out, std::size_t const count) const {
+        out.insert(out.end(), M_MAGIC.begin(), M_MAGIC.end());
+        out.push_back(SNAPSHOT_FORMAT_VERSION);
+        write_number(out, static_cast<unsigned>(m_sections));
+        write_number(out, m_strings.size());
+        for (auto const string : m_strings) {
+            write_number(out, string.size());
+            out.insert(out.end(), string.begin(), string.end());
+        }
+        write_number(out, count);
+        out.insert(out.end(), m_body.begin(), m_body.end());
+    }
+
+   private:
+    static void write_number(std::vector<uint8_t> &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+    void number(uint64_t const value) { write_number(m_body, value); }
+    void signed_number(int64_t const value) {
+        number((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+    void string(std::string_view const value) {
+        auto const [it, inserted] = m_string_index.try_emplace(value, m_strings.size());
+        if (inserted) {
+            m_strings.push_back(value);
+        }
+        number(it->second);
+    }
+    void strings(std::vector<std::string> const &values) {
+        number(values.size());
+        for (auto const &value : values) {
+            string(value);
+        }
+    }
+    /**
+     * @brief Кодирует список флагов маской известных имён и списком остальных
+     */
+    template <std::size_t N>
+    void flags(std::vector<std::string> const &values, std::array<std::string_view, N> const &names) {
+        uint64_t mask = 0;
+        std::vector<std::string_view> extra;
+        for (auto const &value : values) {
+            std::size_t bit = 0;
+            while (bit < N && names[bit] != value) {
+                ++bit;
+            }
+            if (bit < N) {
+                mask |= uint64_t{1} << bit;
+            } else {
+                extra.emplace_back(value);
+            }
+        }
+        number(mask);
+        number(extra.size());
+        for (auto const value : extra) {
+            string(value);
+        }
+    }
+    void packetometr(Packetometr const &value) {
+        number(value.bytes);
+        number(value.packets);
+        number(value.errors);
+        number(value.drops);
+    }
+
+    Section m_sections;                                              /**< Кодируемые секции */
+    std::vector<uint8_t> m_body{};                                   /**< Закодированные интерфейсы */
+    std::vector<std::string_view> m_strings{};                       /**< Таблица строк */
+    std::unordered_map<std::string_view, uint64_t> m_string_index{}; /**< Индекс строки в таблице */
+};
+
+/**
+ * @class SnapshotDecoder
+ * @brief Последовательно разбирает двоичный снимок с проверкой границ
+ */
+class SnapshotDecoder {
+   public:
+    explicit SnapshotDecoder(std::span<uint8_t const> const data) : m_data{data} {}
+
+    std::vector<Json> decode() {
+        for (auto const byte : M_MAGIC) {
+            if (read_byte() != byte) {
+                throw exceptions::DecodeSnapshot("Bad snapshot signature");
+            }
+        }
+        if (uint8_t const version = read_byte(); version != SNAPSHOT_FORMAT_VERSION) {
+            throw exceptions::DecodeSnapshot(::fmt::format("Unsupported snapshot version {}", version));
+        }
+        m_sections = static_cast<Section>(read_number());
+
+        auto const string_count = read_count();
+        m_strings.reserve(string_count);
+        for (std::size_t i = 0; i < string_count; ++i) {
+            auto const size = read_count();
+            m_strings.emplace_back(reinterpret_cast<char const *>(m_data.data() + m_offset), size);
+            m_offset += size;
+        }
+
+        auto const count = read_count();
+        std::vector<Json> interfaces(count);
+        for (auto &info : interfaces) {
+            decode(info);
+        }
+        if (m_offset != m_data.size()) {
+            throw exceptions::DecodeSnapshot("Trailing data after snapshot");
+        }
+        return interfaces;
+    }
+
+   private:
+    void decode(Json &info) {
+        info.interface = string();
+        if (has_section(m_sections, Section::General)) {
+            info.general.state = string();
+            info.general.type = string();
+            info.general.flags = flags(M_LINK_FLAGS);
+            info.general.index = static_cast<int>(signed_number());
+        }
+        if (has_section(m_sections, Section::HW)) {
+            info.hw.type = string();
+            info.hw.mac.resize(read_count());
+            for (auto &mac : info.hw.mac) {
+                mac = string();
+            }
+            info.hw.mtu = read_number();
+            info.hw.size_queue = read_number();
+        }
+        if (has_section(m_sections, Section::OperationalStatus)) {
+            info.operational_status.oper_state = string();
+            info.operational_status.link_mode = string();
+        }
+        if (has_section(m_sections, Section::Protocols)) {
+            uint8_t const bits = read_byte();
+            info.protocols.routing_ipv4 = bits & 1u;
+            info.protocols.multicast = bits & 2u;
+        }
+        if (has_section(m_sections, Section::Ip)) {
+            info.ip.resize(read_count());
+            for (auto &ip : info.ip) {
+                ip.type = string();
+                ip.ip = string();
+                ip.broadcast = string();
+                ip.peer = string();
+                ip.flags = flags(M_ADDR_FLAGS);
+                ip.masc = static_cast<int>(signed_number());
+                ip.valid_lft = static_cast<uint32_t>(read_number());
+                ip.pref_lft = static_cast<uint32_t>(read_number());
+            }
+        }
+        if (has_section(m_sections, Section::Routes)) {
+            info.routes.resize(read_count());
+            for (auto &route : info.routes) {
+                route.destination = string();
+                route.gateway = string();
+                route.type = string();
+                route.metric = static_cast<uint32_t>(read_number());
+                route.table = static_cast<uint32_t>(read_number());
+            }
+        }
+        if (has_section(m_sections, Section::Neigh)) {
+            info.neigh.resize(read_count());
+            for (auto &neigh : info.neigh) {
+                neigh.ip = string();
+                neigh.mac = string();
+                neigh.type = flags(M_NEIGH_STATES);
+            }
+        }
+        if (has_section(m_sections, Section::Tx)) {
+            packetometr(info.tx);
+        }
+        if (has_section(m_sections, Section::Rx)) {
+            packetometr(info.rx);
+        }
+    }
+    uint8_t read_byte() {
+        if (m_offset >= m_data.size()) {
+            throw exceptions::DecodeSnapshot("Unexpected end of snapshot");
+        }
+        return m_data[m_offset++];
+    }
+    uint64_t read_number() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint8_t const byte = read_byte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw exceptions::DecodeSnapshot("Malformed varint in snapshot");
+    }
+    int64_t signed_number() {
+        uint64_t const value = read_number();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+    /**
+     * @brief Читает количество элементов или длину строки
+     *
+     * Каждый элемент занимает хотя бы один байт, поэтому значение, превышающее остаток данных,
+     * означает повреждение (и не приводит к огромному выделению памяти).
+     */
+    std::size_t read_count() {
+        uint64_t const count = read_number();
+        if (count > m_data.size() - m_offset) {
+            throw exceptions::DecodeSnapshot("Count exceeds snapshot size");
+        }
+        return static_cast<std::size_t>(count);
+    }
+    std::string string() {
+        uint64_t const index = read_number();
+        if (index >= m_strings.size()) {
+            throw exceptions::DecodeSnapshot(::fmt::format("String index {} out of range", index));
+        }
+        return std::string{m_strings[index]};
+    }
+    template <std::size_t N>
+    std::vector<std::string> flags(std::array<std::string_view, N> const &names) {
+        uint64_t const mask = read_number();
+        auto const extra = read_count();
+
+        std::vector<std::string> values;
+        values.reserve(static_cast<std::size_t>(std::popcount(mask)) + extra);
+        for (std::size_t bit = 0; bit < N; ++bit) {
+            if (mask & (uint64_t{1} << bit)) {
+                values.emplace_back(names[bit]);
+            }
+        }
+        for (std::size_t i = 0; i < extra; ++i) {
+            values.emplace_back(string());
+        }
+        return values;
+    }
+    void packetometr(Packetometr &value) {
+        value.bytes = read_number();
+        value.packets = read_number();
+        value.errors = read_number();
+        value.drops = read_number();
+    }
+
+    std::span<uint8_t const> m_data;           /**< Данные снимка */
+    std::size_t m_offset{};                    /**< Позиция разбора */
+    Section m_sections{Section::None};         /**< Секции, присутствующие в снимке */
+    std::vector<std::string_view> m_strings{}; /**< Таблица строк (ссылки на данные снимка) */
+};
+
+} // namespace
+
+void encode_snapshot(std::vector<uint8_t> &out, std::vector<Json> const &interfaces, Section const sections) {
+    SnapshotEncoder encoder(sections);
+    for (auto const &info : interfaces) {
+        encoder.encode(info);
+    }
+    encoder.finish(out, interfaces.size());
+}
+
+std::vector<Json> decode_snapshot(std::span<uint8_t const> const data) {
+    return SnapshotDecoder{data}.decode();
+}
+
+} // namespace os::network
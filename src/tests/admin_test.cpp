@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "informer/interface_admin.hpp"
+#include "test_namespace.hpp"
+
+namespace os::network {
+namespace {
+
+/**
+ * Подтверждения пачки приходят отдельными датаграммами и должны разбираться одним вызовом receive_acks.
+ * Служебный поток удерживается в обработчике первой операции пачки, пока объект не начнёт разрушаться:
+ * остальные подтверждения к этому моменту уже в буфере сокета, и операции должны завершиться успешно,
+ * а не с ECANCELED.
+ */
+TEST(InterfaceAdmin, CompletesWholeBatchInOneReceive) {
+    REQUIRE_NAMESPACE();
+    constexpr std::size_t count = 16;
+    auto admin = InterfaceAdmin::create({.max_in_flight = 64});
+    InterfaceAdmin *const raw = admin.get();
+
+    // Пока служебный поток занят обработчиком этой операции, пачка только ставится в очередь
+    // и затем уходит одним системным вызовом.
+    std::promise<void> blocker_entered;
+    std::promise<void> blocker_release;
+    std::shared_future<void> const release = blocker_release.get_future().share();
+    admin->set_interface_state({"lo", true}, [&blocker_entered, release](InterfaceChangeResult const &) {
+        blocker_entered.set_value();
+        release.wait();
+    });
+    blocker_entered.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<InterfaceChangeResult> results;
+    auto const record = [&mutex, &results](InterfaceChangeResult const &result) {
+        std::lock_guard const lock(mutex);
+        results.push_back(result);
+    };
+
+    std::promise<void> first_entered;
+    admin->set_interface_state({"lo", true}, [&, raw](InterfaceChangeResult const &result) {
+        record(result);
+        first_entered.set_value();
+        // Разрушение объекта началось, когда новая операция отклоняется сразу, в вызывающем потоке.
+        for (;;) {
+            auto const cancelled = std::make_shared<bool>(false);
+            raw->set_interface_state({"lo", true}, [cancelled](InterfaceChangeResult const &probe) { *cancelled = probe.error == ECANCELED; });
+            if (*cancelled) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    for (std::size_t i = 1; i < count; ++i) {
+        admin->set_interface_state({"lo", true}, record);
+    }
+
+    blocker_release.set_value();
+    first_entered.get_future().wait();
+    admin.reset();
+
+    ASSERT_EQ(results.size(), count);
+    for (auto const &result : results) {
+        EXPECT_EQ(result.error, 0) << result.message;
+    }
+}
+
+} // namespace
+} // namespace os::network
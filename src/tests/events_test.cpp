@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <net/if.h>
+#include <netlink/route/link.h>
+#include <netlink/route/link/bridge.h>
+#include <netlink/route/link/veth.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "informer/interface_informer.hpp"
+#include "test_namespace.hpp"
+
+namespace os::network {
+namespace {
+
+/**
+ * Исключение одного обработчика не должно прерывать метод, применивший уведомления, и доставку
+ * события остальным подписчикам.
+ */
+TEST(Subscriptions, ThrowingCallbackDoesNotStopDelivery) {
+    REQUIRE_NAMESPACE();
+    auto const informer = InformerNetlink::create({.update_mode = UpdateMode::Events, .preload = Cache::Link});
+    // Другой тест того же процесса мог уже включить lo: без выключения события LinkUp не будет.
+    informer->disable_interface("lo");
+    informer->refresh(0);
+
+    int thrown = 0;
+    std::vector<InterfaceEvent> delivered;
+    informer->subscribe(Event::LinkUp, [&thrown](InterfaceEvent const &) {
+        ++thrown;
+        throw std::runtime_error("subscriber failure");
+    });
+    informer->subscribe(Event::LinkUp, [&delivered](InterfaceEvent const &event) { delivered.push_back(event); });
+
+    EXPECT_NO_THROW(informer->enable_interface("lo"));
+    EXPECT_EQ(thrown, 1);
+    ASSERT_EQ(delivered.size(), 1u);
+    EXPECT_EQ(delivered.front().interface, "lo");
+}
+
+/**
+ * После включения интерфейса менеджер кэшей получает и уведомления AF_INET6 с тем же индексом и именем:
+ * интерфейс должен остаться в списке один раз, а сведения должны браться из объекта AF_UNSPEC.
+ */
+TEST(Events, LinkListedOnceAfterNotifications) {
+    REQUIRE_NAMESPACE();
+    auto const informer = InformerNetlink::create({.update_mode = UpdateMode::Events, .preload = Cache::Link});
+    auto const reference = InformerNetlink::create({.update_mode = UpdateMode::Snapshot});
+
+    EXPECT_NO_THROW(informer->disable_interface("lo"));
+    EXPECT_NO_THROW(informer->enable_interface("lo"));
+    informer->refresh(0);
+
+    auto const names = informer->get_all_interfaces()["interfaces"];
+    EXPECT_EQ(std::count(names.begin(), names.end(), "lo"), 1);
+
+    auto const info = informer->get_interface_info("lo");
+    ASSERT_TRUE(info.contains("hw")) << info.dump();
+    EXPECT_EQ(info["hw"]["size_queue"], reference->get_interface_info("lo")["hw"]["size_queue"]);
+    EXPECT_EQ(informer->get_all_interfaces_info()["interfaces"].size(), names.size());
+}
+
+/**
+ * Мост br0 с портом d0 из пары veth d0/p0. Интерфейсы создаются вызовом create_bridge(), чтобы
+ * экземпляр в режиме UpdateMode::Events мог получить уведомления о них, и удаляются по завершении теста.
+ */
+class BridgePort : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        REQUIRE_NAMESPACE();
+        m_socket.reset(nl_socket_alloc());
+        ASSERT_NE(m_socket, nullptr);
+        ASSERT_EQ(nl_connect(m_socket.get(), NETLINK_ROUTE), 0);
+    }
+
+    void TearDown() override {
+        if (!m_socket) {
+            return;
+        }
+        // Удаление одного интерфейса пары veth удаляет и второй.
+        for (char const *name : {"d0", "br0"}) {
+            std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)> const link{rtnl_link_alloc(), rtnl_link_put};
+            rtnl_link_set_name(link.get(), name);
+            rtnl_link_delete(m_socket.get(), link.get());
+        }
+    }
+
+    void create_bridge() {
+        ASSERT_EQ(rtnl_link_bridge_add(m_socket.get(), "br0"), 0);
+        ASSERT_EQ(rtnl_link_veth_add(m_socket.get(), "d0", "p0", getpid()), 0);
+        ASSERT_EQ(rtnl_link_enslave_ifindex(m_socket.get(), static_cast<int>(if_nametoindex("br0")), static_cast<int>(if_nametoindex("d0"))), 0);
+
+        auto const admin = InformerNetlink::create();
+        for (char const *name : {"br0", "d0", "p0"}) {
+            admin->enable_interface(name);
+        }
+    }
+
+    void set_mtu(char const *name, uint32_t const mtu) {
+        rtnl_link *current = nullptr;
+        ASSERT_EQ(rtnl_link_get_kernel(m_socket.get(), 0, name, &current), 0);
+        std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)> const link{current, rtnl_link_put};
+        std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)> const change{rtnl_link_alloc(), rtnl_link_put};
+        rtnl_link_set_mtu(change.get(), mtu);
+        ASSERT_EQ(rtnl_link_change(m_socket.get(), link.get(), change.get(), 0), 0);
+    }
+
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> m_socket{nullptr, nl_socket_free};
+};
+
+/**
+ * libnl назначает интерфейсу вида bridge семейство AF_BRIDGE, поэтому отбор объектов по семейству
+ * скрыл бы мост. Мост и его порт должны быть в списке ровно один раз в обоих режимах обновления.
+ */
+TEST_F(BridgePort, BridgeListedOnce) {
+    auto const events = InformerNetlink::create({.update_mode = UpdateMode::Events, .preload = Cache::Link});
+    create_bridge();
+    events->refresh(0);
+    auto const snapshot = InformerNetlink::create();
+
+    for (auto *const informer : {events.get(), snapshot.get()}) {
+        auto const names = informer->get_all_interfaces()["interfaces"];
+        EXPECT_EQ(std::count(names.begin(), names.end(), "br0"), 1) << names.dump();
+        EXPECT_EQ(std::count(names.begin(), names.end(), "d0"), 1) << names.dump();
+
+        auto const info = informer->get_interface_info("br0");
+        ASSERT_TRUE(info.contains("hw")) << info.dump();
+        EXPECT_EQ(info["hw"]["size_queue"], snapshot->get_interface_info("br0")["hw"]["size_queue"]);
+    }
+}
+
+/**
+ * Изменение MTU порта моста порождает уведомления AF_BRIDGE о порте и о самом мосте. Они не должны
+ * прерывать refresh() ошибкой менеджера и заменять в кэше полные объекты интерфейсов.
+ */
+TEST_F(BridgePort, PortMtuChangeKeepsCacheConsistent) {
+    auto const informer = InformerNetlink::create({.update_mode = UpdateMode::Events, .preload = Cache::All});
+    create_bridge();
+    ASSERT_NO_THROW(informer->refresh(0));
+
+    set_mtu("d0", 1400);
+    ASSERT_NO_THROW(informer->refresh(0));
+
+    auto const names = informer->get_all_interfaces()["interfaces"];
+    for (char const *name : {"br0", "d0", "p0"}) {
+        EXPECT_EQ(std::count(names.begin(), names.end(), name), 1) << names.dump();
+    }
+    EXPECT_EQ(informer->get_interface_info("d0")["hw"]["mtu"], 1400);
+    auto const bridge = informer->get_interface_info("br0");
+    ASSERT_TRUE(bridge.contains("hw")) << bridge.dump();
+    EXPECT_EQ(bridge["hw"]["size_queue"], InformerNetlink::create()->get_interface_info("br0")["hw"]["size_queue"]);
+}
+
+} // namespace
+} // namespace os::network
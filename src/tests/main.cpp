@@ -0,0 +1,9 @@
+#include <gtest/gtest.h>
+
+#include "test_namespace.hpp"
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    os::network::test::enter_namespace();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "prefix_trie.hpp"
+
+namespace os::network {
+namespace {
+
+/**
+ * @brief Поиск по наибольшему совпадению полным перебором, с которым сравнивается PrefixTrie
+ * @tparam Key Беззнаковый тип ключа
+ */
+template <typename Key>
+class BruteForce {
+   public:
+    static constexpr unsigned M_BITS = sizeof(Key) * 8;
+
+    static Key mask(unsigned const length) { return length == 0 ? Key{0} : static_cast<Key>(~Key{0} << (M_BITS - length)); }
+
+    void insert(Key const key, unsigned const length, int const value) { m_prefixes[{key & mask(length), length}] = value; }
+
+    bool erase(Key const key, unsigned const length) { return m_prefixes.erase({key & mask(length), length}) != 0; }
+
+    [[nodiscard]] int const *match(Key const address) const {
+        int const *best = nullptr;
+        int best_length = -1;
+        for (auto const &[prefix, value] : m_prefixes) {
+            if (static_cast<int>(prefix.second) > best_length && ((address ^ prefix.first) & mask(prefix.second)) == 0) {
+                best = &value;
+                best_length = static_cast<int>(prefix.second);
+            }
+        }
+        return best;
+    }
+
+    [[nodiscard]] std::vector<std::pair<Key, unsigned>> prefixes() const {
+        std::vector<std::pair<Key, unsigned>> result;
+        result.reserve(m_prefixes.size());
+        for (auto const &[prefix, value] : m_prefixes) {
+            result.push_back(prefix);
+        }
+        return result;
+    }
+
+    [[nodiscard]] std::size_t size() const { return m_prefixes.size(); }
+
+   private:
+    std::map<std::pair<Key, unsigned>, int> m_prefixes{};
+};
+
+/**
+ * @brief Случайные префиксы и адреса; часть префиксов продолжает уже созданные, чтобы получались вложенные
+ * @tparam Key Беззнаковый тип ключа
+ */
+template <typename Key>
+class Generator {
+   public:
+    static constexpr unsigned M_BITS = sizeof(Key) * 8;
+
+    explicit Generator(uint32_t const seed) : m_random{seed} {}
+
+    Key address() {
+        Key key{};
+        for (unsigned i = 0; i < M_BITS; i += 32) {
+            key = static_cast<Key>((key << 16) << 16) | static_cast<Key>(m_random());
+        }
+        return key;
+    }
+
+    std::pair<Key, unsigned> prefix(std::vector<std::pair<Key, unsigned>> const &existing) {
+        // Длины ближе к полной разрядности чаще, как в таблицах маршрутизации.
+        unsigned length = std::uniform_int_distribution<unsigned>{0, M_BITS}(m_random);
+        if (length < M_BITS / 2 && m_random() % 2 == 0) {
+            length = M_BITS - length / 4;
+        }
+        if (existing.empty() || m_random() % 3 == 0) {
+            return {address() & BruteForce<Key>::mask(length), length};
+        }
+        auto const &[base, base_length] = existing[m_random() % existing.size()];
+        Key const tail = address() & static_cast<Key>(~BruteForce<Key>::mask(base_length));
+        return {(base | tail) & BruteForce<Key>::mask(length), length};
+    }
+
+    /**
+     * @brief Адреса для проверки: границы и внутренние точки префиксов, а также случайные адреса
+     */
+    std::vector<Key> queries(std::vector<std::pair<Key, unsigned>> const &prefixes, std::size_t const count) {
+        std::vector<Key> result;
+        result.reserve(count * 4);
+        for (std::size_t i = 0; i < count; ++i) {
+            result.push_back(address());
+            if (prefixes.empty()) {
+                continue;
+            }
+            auto const &[key, length] = prefixes[m_random() % prefixes.size()];
+            Key const host = static_cast<Key>(~BruteForce<Key>::mask(length));
+            result.push_back(key);
+            result.push_back(key | host);
+            result.push_back(key | (address() & host));
+        }
+        return result;
+    }
+
+   private:
+    std::mt19937 m_random;
+};
+
+/**
+ * @brief Сравнивает match дерева с перебором на наборе адресов
+ */
+template <typename Key>
+void expect_same_matches(PrefixTrie<Key, int> const &trie, BruteForce<Key> const &reference, std::vector<Key> const &queries) {
+    for (Key const address : queries) {
+        int const *const expected = reference.match(address);
+        int const *const actual = trie.match(address);
+        ASSERT_EQ(expected == nullptr, actual == nullptr) << "size " << reference.size();
+        if (expected) {
+            ASSERT_EQ(*expected, *actual) << "size " << reference.size();
+        }
+    }
+}
+
+/**
+ * Вставка, удаление и поиск с перебором в качестве эталона. Префиксов больше M_JUMP_THRESHOLD, поэтому
+ * проверяется и поиск через таблицу переходов, и её пересчёт при удалении обратно ниже порога.
+ */
+template <typename Key>
+void compare_with_brute_force(uint32_t const seed) {
+    constexpr std::size_t total = PrefixTrie<Key, int>::M_JUMP_THRESHOLD + 1500;
+    constexpr std::size_t checkpoint = 750;
+
+    PrefixTrie<Key, int> trie;
+    BruteForce<Key> reference;
+    Generator<Key> generator{seed};
+    std::vector<std::pair<Key, unsigned>> inserted;
+
+    int next_value = 0;
+    while (reference.size() < total) {
+        auto const [key, length] = generator.prefix(inserted);
+        int const value = next_value++;
+        trie.insert(key, length) = value;
+        reference.insert(key, length, value);
+        inserted.emplace_back(key, length);
+        ASSERT_EQ(trie.size(), reference.size());
+
+        if (reference.size() % checkpoint == 0 || reference.size() == PrefixTrie<Key, int>::M_JUMP_THRESHOLD) {
+            expect_same_matches(trie, reference, generator.queries(inserted, 200));
+        }
+    }
+
+    auto remaining = reference.prefixes();
+    for (auto const &[key, length] : remaining) {
+        int const *const value = trie.find(key, length);
+        ASSERT_NE(value, nullptr);
+    }
+
+    // Удаление в случайном порядке, в том числе до размера ниже порога таблицы переходов.
+    std::shuffle(remaining.begin(), remaining.end(), std::mt19937{seed});
+    std::size_t erased = 0;
+    for (auto const &[key, length] : remaining) {
+        ASSERT_TRUE(trie.erase(key, length));
+        ASSERT_TRUE(reference.erase(key, length));
+        ASSERT_FALSE(trie.erase(key, length));
+        ASSERT_EQ(trie.find(key, length), nullptr);
+        if (++erased % checkpoint == 0) {
+            expect_same_matches(trie, reference, generator.queries(remaining, 200));
+        }
+    }
+    EXPECT_EQ(trie.size(), 0u);
+    expect_same_matches(trie, reference, generator.queries(inserted, 50));
+}
+
+/**
+ * Маршрут по умолчанию (/0) покрывает все адреса, маршрут к узлу (/32) - единственный адрес.
+ */
+TEST(PrefixTrie, Ipv4DefaultAndHostRoutes) {
+    PrefixTrie<uint32_t, int> trie;
+    EXPECT_EQ(trie.match(0x0a000001), nullptr);
+
+    trie.insert(0, 0) = 1;
+    trie.insert(0x0a000000, 8) = 2;
+    trie.insert(0x0a010203, 24) = 3;
+    trie.insert(0x0a010203, 32) = 4;
+    EXPECT_EQ(trie.size(), 4u);
+
+    EXPECT_EQ(*trie.match(0xc0a80001), 1);
+    EXPECT_EQ(*trie.match(0x0a7f0000), 2);
+    EXPECT_EQ(*trie.match(0x0a0102ff), 3);
+    EXPECT_EQ(*trie.match(0x0a010203), 4);
+
+    // Биты за пределами длины префикса игнорируются.
+    ASSERT_NE(trie.find(0x0a0102ff, 24), nullptr);
+    EXPECT_EQ(*trie.find(0x0a0102ff, 24), 3);
+    EXPECT_EQ(trie.find(0x0a010200, 16), nullptr);
+    EXPECT_EQ(&trie.insert(0x0a010200, 24), trie.find(0x0a010203, 24));
+    EXPECT_EQ(trie.size(), 4u);
+
+    EXPECT_TRUE(trie.erase(0x0a010203, 32));
+    EXPECT_EQ(*trie.match(0x0a010203), 3);
+    EXPECT_TRUE(trie.erase(0, 0));
+    EXPECT_EQ(trie.match(0xc0a80001), nullptr);
+    EXPECT_EQ(*trie.match(0x0a7f0000), 2);
+    EXPECT_FALSE(trie.erase(0, 0));
+
+    trie.clear();
+    EXPECT_EQ(trie.size(), 0u);
+    EXPECT_EQ(trie.match(0x0a010203), nullptr);
+}
+
+/**
+ * То же для 128-битных ключей: старшие и младшие 64 бита ключа должны учитываться одинаково.
+ */
+TEST(PrefixTrie, Ipv6DefaultAndHostRoutes) {
+    Ipv6Key const documentation = static_cast<Ipv6Key>(0x20010db8) << 96;
+    Ipv6Key const host = documentation | 1;
+
+    PrefixTrie<Ipv6Key, int> trie;
+    trie.insert(0, 0) = 1;
+    trie.insert(documentation, 32) = 2;
+    trie.insert(host, 128) = 3;
+
+    EXPECT_EQ(*trie.match(static_cast<Ipv6Key>(0xfe80) << 112), 1);
+    EXPECT_EQ(*trie.match(documentation | 2), 2);
+    EXPECT_EQ(*trie.match(host), 3);
+
+    EXPECT_TRUE(trie.erase(documentation, 32));
+    EXPECT_EQ(*trie.match(documentation | 2), 1);
+    EXPECT_EQ(*trie.match(host), 3);
+    EXPECT_TRUE(trie.erase(host, 128));
+    EXPECT_EQ(*trie.match(host), 1);
+    EXPECT_EQ(trie.size(), 1u);
+}
+
+TEST(PrefixTrie, Ipv4MatchesBruteForce) {
+    compare_with_brute_force<uint32_t>(4);
+}
+
+TEST(PrefixTrie, Ipv6MatchesBruteForce) {
+    compare_with_brute_force<Ipv6Key>(6);
+}
+
+} // namespace
+} // namespace os::network
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <net/if.h>
+#include <netlink/route/link.h>
+#include <netlink/route/link/veth.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "informer/counter_sampler.hpp"
+#include "test_namespace.hpp"
+
+namespace os::network {
+namespace {
+
+/**
+ * @brief Переименовывает выключенный интерфейс
+ */
+void rename_link(nl_sock *socket, char const *from, char const *to) {
+    rtnl_link *current = nullptr;
+    ASSERT_EQ(rtnl_link_get_kernel(socket, 0, from, &current), 0);
+    std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)> const link{current, rtnl_link_put};
+    std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)> const change{rtnl_link_alloc(), rtnl_link_put};
+    rtnl_link_set_name(change.get(), to);
+    ASSERT_EQ(rtnl_link_change(socket, link.get(), change.get(), 0), 0);
+}
+
+/**
+ * Интерфейс с меньшим индексом получает имя интерфейса с большим индексом, а тот - новое имя.
+ * Дамп идёт по возрастанию индекса, поэтому освобождение прежнего имени второго интерфейса
+ * не должно удалять имя, уже перешедшее к первому.
+ */
+TEST(CounterSampler, KeepsNameTakenOverInSameDump) {
+    REQUIRE_NAMESPACE();
+    std::unique_ptr<nl_sock, decltype(&nl_socket_free)> const socket{nl_socket_alloc(), nl_socket_free};
+    ASSERT_NE(socket, nullptr);
+    ASSERT_EQ(nl_connect(socket.get(), NETLINK_ROUTE), 0);
+    ASSERT_EQ(rtnl_link_veth_add(socket.get(), "s0", "s1", getpid()), 0);
+
+    std::string lower = "s0";
+    std::string higher = "s1";
+    if (if_nametoindex("s0") > if_nametoindex("s1")) {
+        std::swap(lower, higher);
+    }
+
+    auto const sampler = CounterSampler::create();
+    sampler->sample();
+    rename_link(socket.get(), higher.c_str(), "s2");
+    rename_link(socket.get(), lower.c_str(), higher.c_str());
+    sampler->sample();
+
+    EXPECT_TRUE(sampler->get_rates(higher, std::chrono::hours{1}).has_value());
+    EXPECT_TRUE(sampler->get_rates("s2", std::chrono::hours{1}).has_value());
+    EXPECT_FALSE(sampler->get_rates(lower, std::chrono::hours{1}).has_value());
+
+    std::unique_ptr<rtnl_link, decltype(&rtnl_link_put)> const link{rtnl_link_alloc(), rtnl_link_put};
+    rtnl_link_set_name(link.get(), "s2");
+    rtnl_link_delete(socket.get(), link.get());
+}
+
+} // namespace
+} // namespace os::network
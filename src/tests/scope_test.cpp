@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+
+#include "informer/interface_informer.hpp"
+#include "test_namespace.hpp"
+
+namespace os::network {
+namespace {
+
+/**
+ * Индекс поиска маршрута строится из кэша, ограниченного DumpScope. Поиск, ответ на который зависит
+ * от отброшенных маршрутов, должен отклоняться, а не возвращать std::nullopt как для недостижимого адреса.
+ */
+TEST(DumpScope, RejectsRouteLookupOutsideScope) {
+    REQUIRE_NAMESPACE();
+    InformerNetlink::create()->enable_interface("lo");
+
+    auto const by_table = InformerNetlink::create({.scope = {.table = RT_TABLE_LOCAL}});
+    auto const local = by_table->lookup_route("127.0.0.1", RT_TABLE_LOCAL);
+    ASSERT_TRUE(local.has_value());
+    EXPECT_EQ(local->interface, "lo");
+    EXPECT_THROW(by_table->lookup_route("127.0.0.1"), exceptions::OutOfScope);
+    EXPECT_THROW(by_table->lookup_route("127.0.0.1", RT_TABLE_MAIN), exceptions::OutOfScope);
+
+    auto const by_family = InformerNetlink::create({.scope = {.family = AF_INET}});
+    EXPECT_TRUE(by_family->lookup_route("127.0.0.1").has_value());
+    EXPECT_THROW(by_family->lookup_route("::1"), exceptions::OutOfScope);
+
+    auto const by_interface = InformerNetlink::create({.scope = {.interface = "lo"}});
+    EXPECT_THROW(by_interface->lookup_route("127.0.0.1"), exceptions::OutOfScope);
+}
+
+} // namespace
+} // namespace os::network
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "informer/snapshot_codec.hpp"
+
+namespace os::network {
+namespace {
+
+/**
+ * @brief Два интерфейса со всеми заполненными секциями; строки повторяются, чтобы проверялась таблица строк
+ */
+std::vector<Json> sample_interfaces() {
+    Json loopback;
+    loopback.interface = "lo";
+    loopback.general = {.state = "UP", .type = "LOOPBACK", .flags = {"UP", "LOOPBACK", "RUNNING"}, .index = 1};
+    loopback.hw = {.type = "Loopback", .mac = {"00:00:00:00:00:00"}, .mtu = 65536, .size_queue = 1000};
+    loopback.operational_status = {.oper_state = "UNKNOWN", .link_mode = "DEFAULT"};
+    loopback.protocols = {.routing_ipv4 = true, .multicast = false};
+    loopback.ip = {{.type = "IPv4", .ip = "127.0.0.1/8", .flags = {"PERMANENT"}, .masc = 8, .valid_lft = 0xffffffff, .pref_lft = 0xffffffff}};
+    loopback.routes = {{.destination = "127.0.0.0/8", .type = "LOCAL", .metric = 0, .table = 255}};
+    loopback.tx = {.bytes = std::numeric_limits<uint64_t>::max(), .packets = 1, .errors = 0, .drops = 127};
+    loopback.rx = {.bytes = 128, .packets = 16384, .errors = 2, .drops = 0};
+
+    Json ethernet;
+    ethernet.interface = "eth0";
+    // Имя, которого нет среди известных флагов, передаётся строкой после маски известных.
+    ethernet.general = {.state = "UP", .type = "BROADCAST", .flags = {"UP", "BROADCAST", "RUNNING", "MULTICAST", "LOWER_UP"}, .index = -1};
+    ethernet.hw = {.type = "Ethernet", .mac = {"02:00:00:00:00:01", "02:00:00:00:00:02"}, .mtu = 1500, .size_queue = 1000};
+    ethernet.operational_status = {.oper_state = "UP", .link_mode = "DEFAULT"};
+    ethernet.protocols = {.routing_ipv4 = false, .multicast = true};
+    ethernet.ip = {{.type = "IPv4", .ip = "192.0.2.1/24", .broadcast = "192.0.2.255", .flags = {"PERMANENT"}, .masc = 24},
+                   {.type = "IPv6", .ip = "2001:db8::1/64", .flags = {"NODAD", "OPTIMISTIC", "MANAGETEMPADDR"}, .masc = 64, .valid_lft = 300, .pref_lft = 120}};
+    ethernet.routes = {{.destination = "0.0.0.0/0", .gateway = "192.0.2.254", .type = "UNICAST", .metric = 100, .table = 254},
+                       {.destination = "192.0.2.0/24", .type = "UNICAST", .metric = 100, .table = 254}};
+    ethernet.neigh = {{.ip = "192.0.2.254", .mac = "02:00:00:00:00:fe", .type = {"REACHABLE"}},
+                      {.ip = "192.0.2.7", .mac = "", .type = {"INCOMPLETE", "FAILED"}}};
+    ethernet.rx = {.bytes = 1, .packets = 2, .errors = 3, .drops = 4};
+
+    return {loopback, ethernet};
+}
+
+/**
+ * @brief Оставляет в интерфейсе только секции маски, как их восстанавливает decode_snapshot
+ */
+Json project(Json const &info, Section const sections) {
+    Json result;
+    result.interface = info.interface;
+    if (has_section(sections, Section::General)) {
+        result.general = info.general;
+    }
+    if (has_section(sections, Section::HW)) {
+        result.hw = info.hw;
+    }
+    if (has_section(sections, Section::OperationalStatus)) {
+        result.operational_status = info.operational_status;
+    }
+    if (has_section(sections, Section::Protocols)) {
+        result.protocols = info.protocols;
+    }
+    if (has_section(sections, Section::Ip)) {
+        result.ip = info.ip;
+    }
+    if (has_section(sections, Section::Routes)) {
+        result.routes = info.routes;
+    }
+    if (has_section(sections, Section::Neigh)) {
+        result.neigh = info.neigh;
+    }
+    if (has_section(sections, Section::Tx)) {
+        result.tx = info.tx;
+    }
+    if (has_section(sections, Section::Rx)) {
+        result.rx = info.rx;
+    }
+    return result;
+}
+
+/**
+ * Разбор закодированного снимка возвращает исходные интерфейсы для каждой маски секций;
+ * секции вне маски остаются значениями по умолчанию.
+ */
+TEST(SnapshotCodec, RoundTripsEverySectionMask) {
+    auto const interfaces = sample_interfaces();
+    for (unsigned bits = 0; bits <= static_cast<unsigned>(Section::All); ++bits) {
+        auto const sections = static_cast<Section>(bits);
+        std::vector<uint8_t> encoded;
+        encode_snapshot(encoded, interfaces, sections);
+
+        auto const decoded = decode_snapshot(encoded);
+        ASSERT_EQ(decoded.size(), interfaces.size()) << "sections " << bits;
+        for (std::size_t i = 0; i < interfaces.size(); ++i) {
+            EXPECT_EQ(nlohmann::json(decoded[i]), nlohmann::json(project(interfaces[i], sections))) << "sections " << bits;
+        }
+    }
+
+    std::vector<uint8_t> empty;
+    encode_snapshot(empty, {});
+    EXPECT_TRUE(decode_snapshot(empty).empty());
+}
+
+/**
+ * Известные имена флагов восстанавливаются в порядке бит маски, остальные следуют за ними.
+ */
+TEST(SnapshotCodec, MovesUnknownFlagsAfterKnownOnes) {
+    Json info;
+    info.interface = "eth0";
+    info.general.flags = {"LOWER_UP", "MULTICAST", "UP"};
+
+    std::vector<uint8_t> encoded;
+    encode_snapshot(encoded, {info}, Section::General);
+    auto const decoded = decode_snapshot(encoded);
+    ASSERT_EQ(decoded.size(), 1u);
+    EXPECT_EQ(decoded.front().general.flags, (std::vector<std::string>{"UP", "MULTICAST", "LOWER_UP"}));
+}
+
+/**
+ * Любой неполный снимок отклоняется исключением, а не читается за границей данных.
+ */
+TEST(SnapshotCodec, RejectsTruncatedSnapshot) {
+    std::vector<uint8_t> encoded;
+    encode_snapshot(encoded, sample_interfaces());
+
+    for (std::size_t size = 0; size < encoded.size(); ++size) {
+        EXPECT_THROW(decode_snapshot(std::span<uint8_t const>{encoded.data(), size}), exceptions::DecodeSnapshot) << "size " << size;
+    }
+
+    encoded.push_back(0);
+    EXPECT_THROW(decode_snapshot(encoded), exceptions::DecodeSnapshot);
+}
+
+/**
+ * Данные с чужой сигнатурой или неподдерживаемой версией формата отклоняются.
+ */
+TEST(SnapshotCodec, RejectsBadMagicAndVersion) {
+    std::vector<uint8_t> encoded;
+    encode_snapshot(encoded, sample_interfaces());
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        auto corrupted = encoded;
+        corrupted[i] ^= 0x20;
+        EXPECT_THROW(decode_snapshot(corrupted), exceptions::DecodeSnapshot) << "byte " << i;
+    }
+
+    auto future = encoded;
+    future[3] = SNAPSHOT_FORMAT_VERSION + 1;
+    EXPECT_THROW(decode_snapshot(future), exceptions::DecodeSnapshot);
+}
+
+} // namespace
+} // namespace os::network
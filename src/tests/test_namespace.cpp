@@ -0,0 +1,63 @@
+#include "test_namespace.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace os::network::test {
+
+namespace {
+
+std::string g_namespace_error{"enter_namespace() не вызывался"}; /**< Ошибка перехода в пространство имен */
+
+/**
+ * @brief Записывает строку в файл /proc/self/...
+ * @param path Путь
+ * @param value Содержимое
+ * @return Описание ошибки или пустая строка
+ */
+std::string write_proc(char const *path, std::string const &value) {
+    int const fd = ::open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return fmt::format("Open {}: {}", path, std::strerror(errno));
+    }
+    ssize_t const written = ::write(fd, value.data(), value.size());
+    int const error = errno;
+    ::close(fd);
+    if (written != static_cast<ssize_t>(value.size())) {
+        return fmt::format("Write {}: {}", path, std::strerror(error));
+    }
+    return {};
+}
+
+} // namespace
+
+void enter_namespace() {
+    uid_t const uid = ::geteuid();
+    gid_t const gid = ::getegid();
+    if (uid == 0) {
+        g_namespace_error = ::unshare(CLONE_NEWNET) == 0 ? std::string{} : fmt::format("Unshare network namespace: {}", std::strerror(errno));
+        return;
+    }
+
+    if (::unshare(CLONE_NEWUSER | CLONE_NEWNET) != 0) {
+        g_namespace_error = fmt::format("Unshare user and network namespaces: {}", std::strerror(errno));
+        return;
+    }
+    g_namespace_error = write_proc("/proc/self/setgroups", "deny");
+    if (g_namespace_error.empty()) {
+        g_namespace_error = write_proc("/proc/self/uid_map", fmt::format("0 {} 1", uid));
+    }
+    if (g_namespace_error.empty()) {
+        g_namespace_error = write_proc("/proc/self/gid_map", fmt::format("0 {} 1", gid));
+    }
+}
+std::string const &namespace_error() {
+    return g_namespace_error;
+}
+
+} // namespace os::network::test
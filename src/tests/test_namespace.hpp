@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+namespace os::network::test {
+
+/**
+ * @brief Переводит процесс в новое пустое сетевое пространство имен
+ *
+ * Без прав root дополнительно создаётся пространство имен пользователя, в котором текущий
+ * пользователь отображается в root. Вызывается из main до создания потоков; ошибка запоминается,
+ * и тесты, которым нужно ядро, пропускаются.
+ */
+void enter_namespace();
+/**
+ * @brief Возвращает описание ошибки перехода в пространство имен
+ * @return Пустая строка, если процесс находится в собственном пространстве имен
+ */
+std::string const &namespace_error();
+
+} // namespace os::network::test
+
+/**
+ * @brief Пропускает тест, если процесс не смог перейти в собственное сетевое пространство имен
+ */
+#define REQUIRE_NAMESPACE()                                             \
+    do {                                                                \
+        if (!::os::network::test::namespace_error().empty()) {          \
+            GTEST_SKIP() << ::os::network::test::namespace_error();     \
+        }                                                               \
+    } while (false)